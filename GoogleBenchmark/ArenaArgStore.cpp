@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include "ArenaArgStore.h"
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "SampleData.h"
+#include "fmt/args.h"
+#include <string>
+#include <vector>
+
+// A GML record of state.range(0) arguments assembled at runtime, four per
+// Sample_t (flag, id, range, name), built into an argument store and
+// formatted. Both stores are reused across iterations, so what differs is
+// fmt's heap node per copied argument against the arena.
+class ArgStoreFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    std::vector<std::string> names;
+    std::string positional;
+    std::string named;
+    fmt::memory_buffer out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        const auto records = static_cast<size_t>(state.range(0)) / 4;
+        samples = makeSamples(records);
+        positional.clear();
+        named.clear();
+        names.clear();
+        for (size_t i = 0; i < records; ++i) {
+            positional += ";$Flag Value:$ {:s};$Launcher ID:$ {};$Predicted Intercept Range:$ {:.3f} dm;$Platform Name:$ {}";
+            named += fmt::format(";$Flag Value:$ {{flag{0}:s}};$Launcher ID:$ {{id{0}}}"
+                ";$Predicted Intercept Range:$ {{range{0}:.3f}} dm;$Platform Name:$ {{name{0}}}", i);
+            for (const char* field : { "flag", "id", "range", "name" }) {
+                names.push_back(fmt::format("{}{}", field, i));
+            }
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+        names.clear();
+    }
+
+    // Names and flags go in as const char*, so both stores copy them
+    template <typename Store>
+    void build(Store& store) const {
+        for (const auto& s : samples) {
+            const char* yesOrNo = (s.flag == 0) ? "No" : "Yes";
+            const char* name = s.name;
+            store.push_back(yesOrNo);
+            store.push_back(s.id);
+            store.push_back(s.value);
+            store.push_back(name);
+        }
+    }
+
+    template <typename Store>
+    void buildNamed(Store& store) const {
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const auto& s = samples[i];
+            const char* yesOrNo = (s.flag == 0) ? "No" : "Yes";
+            const char* name = s.name;
+            store.push_back(fmt::arg(names[4 * i].c_str(), yesOrNo));
+            store.push_back(fmt::arg(names[4 * i + 1].c_str(), s.id));
+            store.push_back(fmt::arg(names[4 * i + 2].c_str(), s.value));
+            store.push_back(fmt::arg(names[4 * i + 3].c_str(), name));
+        }
+    }
+};
+
+static void argCountArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("args")->Arg(4)->Arg(16)->Arg(64);
+}
+
+BENCHMARK_DEFINE_F(ArgStoreFixture, GML_args_dynamic_store)(benchmark::State& state) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        store.clear();
+        build(store);
+        out.clear();
+        fmt::vformat_to(fmt::appender(out), positional, store);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(ArgStoreFixture, GML_args_dynamic_store)->Apply(argCountArgs);
+
+BENCHMARK_DEFINE_F(ArgStoreFixture, GML_args_arena_store)(benchmark::State& state) {
+    ArenaFormatArgStore<> store;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        store.clear();
+        build(store);
+        out.clear();
+        fmt::vformat_to(fmt::appender(out), positional, store);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(ArgStoreFixture, GML_args_arena_store)->Apply(argCountArgs);
+
+BENCHMARK_DEFINE_F(ArgStoreFixture, GML_args_dynamic_store_named)(benchmark::State& state) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        store.clear();
+        buildNamed(store);
+        out.clear();
+        fmt::vformat_to(fmt::appender(out), named, store);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(ArgStoreFixture, GML_args_dynamic_store_named)->Apply(argCountArgs);
+
+BENCHMARK_DEFINE_F(ArgStoreFixture, GML_args_arena_store_named)(benchmark::State& state) {
+    ArenaFormatArgStore<> store;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        store.clear();
+        buildNamed(store);
+        out.clear();
+        fmt::vformat_to(fmt::appender(out), named, store);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(ArgStoreFixture, GML_args_arena_store_named)->Apply(argCountArgs);
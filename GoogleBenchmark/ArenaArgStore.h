@@ -0,0 +1,173 @@
+#pragma once
+#include "ArenaBuffer.h"
+#include "fmt/args.h"
+#include "fmt/format.h"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// fmt::dynamic_format_arg_store without a heap node per argument, for
+// records whose layout is only known at runtime. Arguments, named-argument
+// info and copied values (strings, custom types) live in inline storage
+// first and spill into an Arena, so a store reused record after record
+// settles into no allocations at all: clear() keeps the arena's memory.
+//
+// Strings are copied as characters and passed on as string views, which
+// formats the same as the std::string copy fmt's store makes. Copied custom
+// types are destroyed on clear(). The store refers into itself and so can be
+// neither copied nor moved.
+template <typename Context = fmt::format_context, size_t InlineArgs = 16, size_t InlineBytes = 512>
+class ArenaFormatArgStore {
+    using Char = typename Context::char_type;
+    using Arg = fmt::basic_format_arg<Context>;
+    using NamedInfo = fmt::detail::named_arg_info<Char>;
+
+    // Same rule as fmt's store: strings and custom types are copied unless
+    // passed as views or through std::ref
+    template <typename T>
+    static constexpr bool NEEDS_COPY = [] {
+        constexpr auto mapped = fmt::detail::mapped_type_constant<T, Char>::value;
+        return !fmt::detail::is_reference_wrapper<T>::value &&
+            !std::is_same_v<T, fmt::basic_string_view<Char>> &&
+            !std::is_same_v<T, std::basic_string_view<Char>> &&
+            (mapped == fmt::detail::type::cstring_type || mapped == fmt::detail::type::string_type ||
+                mapped == fmt::detail::type::custom_type);
+    }();
+
+    template <typename T>
+    static constexpr bool IS_STRING = fmt::detail::mapped_type_constant<T, Char>::value == fmt::detail::type::cstring_type ||
+        fmt::detail::mapped_type_constant<T, Char>::value == fmt::detail::type::string_type;
+
+public:
+    ArenaFormatArgStore() = default;
+    ~ArenaFormatArgStore() { destroyCopies(); }
+    ArenaFormatArgStore(const ArenaFormatArgStore&) = delete;
+    ArenaFormatArgStore& operator=(const ArenaFormatArgStore&) = delete;
+
+    operator fmt::basic_format_args<Context>() const {
+        return fmt::basic_format_args<Context>(args + 1, static_cast<int>(count), namedCount != 0);
+    }
+
+    template <typename T>
+    void push_back(const T& arg) {
+        if constexpr (NEEDS_COPY<T>) {
+            emplace(copy(arg));
+        } else {
+            emplace(fmt::detail::unwrap(arg));
+        }
+    }
+
+    // The name is always copied
+    template <typename T>
+    void push_back(const fmt::detail::named_arg<Char, T>& arg) {
+        if constexpr (NEEDS_COPY<T>) {
+            emplace(copy(arg.value));
+        } else {
+            emplace(fmt::detail::unwrap(arg.value));
+        }
+        if (namedCount == namedCapacity) {
+            namedInfo = grow(namedInfo, namedCount, namedCapacity);
+        }
+        namedInfo[namedCount++] = { copyString(fmt::basic_string_view<Char>(arg.name)).data(),
+            static_cast<int>(count - 1) };
+        args[0] = Arg(namedInfo, namedCount);
+    }
+
+    // Forgets every argument and copy; inline storage and the arena's memory
+    // are kept for the next record
+    void clear() {
+        destroyCopies();
+        args = inlineArgs;
+        argCapacity = InlineArgs;
+        count = 0;
+        namedInfo = inlineNamedInfo;
+        namedCapacity = InlineArgs;
+        namedCount = 0;
+        inlineUsed = 0;
+        arena.reset();
+    }
+
+    size_t size() const { return count; }
+
+private:
+    // Copies of non-trivially destructible values, destroyed newest first
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    void* allocate(const size_t bytes, const size_t alignment) {
+        const size_t offset = (inlineUsed + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes <= InlineBytes) {
+            inlineUsed = offset + bytes;
+            return inlineBytes + offset;
+        }
+        return arena.allocate(bytes, alignment);
+    }
+
+    fmt::basic_string_view<Char> copyString(const fmt::basic_string_view<Char> text) {
+        auto* chars = static_cast<Char*>(allocate((text.size() + 1) * sizeof(Char), alignof(Char)));
+        std::memcpy(chars, text.data(), text.size() * sizeof(Char));
+        chars[text.size()] = Char();
+        return { chars, text.size() };
+    }
+
+    template <typename T>
+    auto copy(const T& value) {
+        if constexpr (IS_STRING<T>) {
+            return copyString(fmt::basic_string_view<Char>(value));
+        } else {
+            auto* object = ::new (allocate(sizeof(T), alignof(T))) T(value);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                auto* node = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+                *node = { [](void* p) { static_cast<T*>(p)->~T(); }, object, destructors };
+                destructors = node;
+            }
+            return std::cref(*object);
+        }
+    }
+
+    template <typename T>
+    void emplace(const T& value) {
+        // Slot 0 is reserved for the named-argument info
+        if (count + 1 == argCapacity) {
+            args = grow(args, count + 1, argCapacity);
+        }
+        args[++count] = Arg(fmt::detail::unwrap(value));
+    }
+
+    // Moves a full array into the arena at twice the capacity; the old one
+    // stays where it is until clear()
+    template <typename T>
+    T* grow(const T* items, const size_t used, size_t& capacity) {
+        capacity *= 2;
+        auto* grown = static_cast<T*>(allocate(capacity * sizeof(T), alignof(T)));
+        std::memcpy(static_cast<void*>(grown), items, used * sizeof(T));
+        return grown;
+    }
+
+    void destroyCopies() {
+        for (auto* node = destructors; node != nullptr; node = node->next) {
+            node->destroy(node->object);
+        }
+        destructors = nullptr;
+    }
+
+    Arg inlineArgs[InlineArgs];
+    NamedInfo inlineNamedInfo[InlineArgs];
+    alignas(std::max_align_t) std::byte inlineBytes[InlineBytes];
+
+    Arg* args{ inlineArgs };
+    size_t argCapacity{ InlineArgs };
+    size_t count{ 0 };
+    NamedInfo* namedInfo{ inlineNamedInfo };
+    size_t namedCapacity{ InlineArgs };
+    size_t namedCount{ 0 };
+    size_t inlineUsed{ 0 };
+    Destructor* destructors{ nullptr };
+    Arena arena{ 4 * 1'024 };
+};
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include "ArenaBuffer.h"
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "SampleData.h"
+#include <vector>
+
+// GML batches of state.range(0) bytes formatted into a fresh
+// basic_memory_buffer per iteration: the default allocator against the
+// arena, each with fmt's 1.5x growth and with page-aligned doubling
+class ArenaBufferFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+
+    void SetUp(const ::benchmark::State& state) override {
+        // Enough records to reach the target size
+        const auto target = static_cast<size_t>(state.range(0));
+        samples = makeSamples(1'024);
+        char record[MAX_SAMPLE_SIZE + GML_HEADROOM];
+        size_t size = 0;
+        size_t count = 0;
+        while (size < target) {
+            size += static_cast<size_t>(writeSample(record, samples[count % samples.size()]) - record);
+            ++count;
+        }
+        std::vector<Sample_t> batch(count);
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = samples[i % samples.size()];
+        }
+        samples = std::move(batch);
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples = {};
+    }
+
+    template <typename Buffer>
+    void formatBatch(Buffer& buffer) const {
+        for (const auto& s : samples) {
+            const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+            fmt::format_to(fmt::appender(buffer),
+                ";$Flag Value:$ {:s};$Launcher ID:$ {};$Predicted Intercept Range:$ {:.3f} dm;$Platform Name:$ {}",
+                yesOrNo, s.id, s.value, s.name);
+        }
+    }
+};
+
+static void batchBytesArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("bytes")->RangeMultiplier(4)->Range(1 << 10, 1 << 20);
+}
+
+BENCHMARK_DEFINE_F(ArenaBufferFixture, GML_buffer_default)(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        fmt::memory_buffer buffer;
+        formatBatch(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArenaBufferFixture, GML_buffer_default)->Apply(batchBytesArgs);
+
+BENCHMARK_DEFINE_F(ArenaBufferFixture, GML_buffer_default_page_doubling)(benchmark::State& state) {
+    using Buffer = fmt::basic_memory_buffer<char, fmt::inline_buffer_size,
+        HeapGrowthAllocator<char, PageDoublingGrowth<>>>;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        Buffer buffer;
+        formatBatch(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArenaBufferFixture, GML_buffer_default_page_doubling)->Apply(batchBytesArgs);
+
+BENCHMARK_DEFINE_F(ArenaBufferFixture, GML_buffer_arena)(benchmark::State& state) {
+    Arena arena;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        {
+            ArenaMemoryBuffer<> buffer{ ArenaAllocator<char>(arena) };
+            formatBatch(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        arena.reset();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArenaBufferFixture, GML_buffer_arena)->Apply(batchBytesArgs);
+
+BENCHMARK_DEFINE_F(ArenaBufferFixture, GML_buffer_arena_page_doubling)(benchmark::State& state) {
+    Arena arena;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        {
+            ArenaMemoryBuffer<PageDoublingGrowth<>> buffer{ ArenaAllocator<char, PageDoublingGrowth<>>(arena) };
+            formatBatch(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        arena.reset();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArenaBufferFixture, GML_buffer_arena_page_doubling)->Apply(batchBytesArgs);
@@ -0,0 +1,127 @@
+#pragma once
+#include "fmt/format.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Bump-pointer arena. Allocation moves a pointer forward inside the current
+// chunk; deallocation is a no-op and reset() releases everything at once.
+// Requests that do not fit open a new chunk of at least chunkSize bytes. On
+// reset a multi-chunk arena is coalesced into one chunk of the total size,
+// so a workload that repeats settles into a single chunk and no mallocs.
+class Arena {
+public:
+    explicit Arena(const size_t chunkSize = 64 * 1'024) : chunkSize(chunkSize) {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(const size_t bytes, const size_t alignment = alignof(std::max_align_t)) {
+        auto offset = (used + alignment - 1) & ~(alignment - 1);
+        if (chunks.empty() || offset + bytes > chunks.back().size) {
+            addChunk(std::max(bytes + alignment, chunkSize));
+            offset = (used + alignment - 1) & ~(alignment - 1);
+        }
+        used = offset + bytes;
+        return chunks.back().data.get() + offset;
+    }
+
+    void reset() {
+        if (chunks.size() > 1) {
+            size_t total = 0;
+            for (const auto& chunk : chunks) {
+                total += chunk.size;
+            }
+            chunks.clear();
+            addChunk(total);
+        }
+        used = 0;
+    }
+
+    size_t chunkCount() const { return chunks.size(); }
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    void addChunk(const size_t size) {
+        chunks.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+        used = 0;
+    }
+
+    size_t chunkSize;
+    size_t used{ 0 };
+    std::vector<Chunk> chunks;
+};
+
+// Growth policies for fmt::basic_memory_buffer, picked up by its
+// grow_capacity hook through the allocators below
+
+// fmt's own policy: 1.5x
+struct FmtGrowth {
+    static size_t next(const size_t oldCapacity, const size_t size) {
+        return std::max(size, oldCapacity + oldCapacity / 2);
+    }
+};
+
+// Doubling, rounded up to whole pages, so large buffers grow in fewer and
+// page-aligned steps
+template <size_t PageSize = 4'096>
+struct PageDoublingGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "page size must be a power of two");
+    static size_t next(const size_t oldCapacity, const size_t size) {
+        const size_t wanted = std::max(size, 2 * oldCapacity);
+        return (wanted + PageSize - 1) & ~(PageSize - 1);
+    }
+};
+
+// Arena-backed allocator for fmt::basic_memory_buffer. The arena must
+// outlive every buffer using it.
+template <typename T, typename Growth = FmtGrowth>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    ArenaAllocator() = default;  // Only as a move target: basic_memory_buffer's move assigns it
+    explicit ArenaAllocator(Arena& arena) : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U, Growth>& other) : arena(other.arena) {}
+
+    T* allocate(const size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+
+    size_t grow_capacity(const size_t oldCapacity, const size_t size) const { return Growth::next(oldCapacity, size); }
+
+    bool operator==(const ArenaAllocator& other) const { return arena == other.arena; }
+
+private:
+    template <typename, typename>
+    friend class ArenaAllocator;
+
+    Arena* arena{ nullptr };
+};
+
+// Heap allocation with a growth policy, to separate the policy's effect
+// from the arena's
+template <typename T, typename Growth>
+struct HeapGrowthAllocator : std::allocator<T> {
+    HeapGrowthAllocator() = default;
+    template <typename U>
+    HeapGrowthAllocator(const HeapGrowthAllocator<U, Growth>&) {}
+
+    size_t grow_capacity(const size_t oldCapacity, const size_t size) const { return Growth::next(oldCapacity, size); }
+};
+
+template <typename Growth = FmtGrowth>
+using ArenaMemoryBuffer = fmt::basic_memory_buffer<char, fmt::inline_buffer_size, ArenaAllocator<char, Growth>>;
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include "CompiledFormat.h"
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "SampleData.h"
+#include "fmt/compile.h"
+#include <array>
+#include <string>
+#include <vector>
+
+// The four GML label templates as if loaded from configuration: runtime
+// strings, so fmt can only take them through vformat_to
+class RuntimeTemplateFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    std::array<std::string, 4> templates;
+    char out[MAX_SAMPLE_SIZE + GML_HEADROOM]{};
+
+    void SetUp(const ::benchmark::State& /*state*/) override {
+        samples = makeSamples(1'024);
+        templates = {
+            ";$Flag Value:$ {:s}",
+            ";$Launcher ID:$ {}",
+            ";$Predicted Intercept Range:$ {:.3f} dm",
+            ";$Platform Name:$ {}"
+        };
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+    }
+
+    char* writeVformat(char* dst, const Sample_t& s) const {
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        dst = fmt::vformat_to(dst, templates[0], fmt::make_format_args(yesOrNo));
+        dst = fmt::vformat_to(dst, templates[1], fmt::make_format_args(s.id));
+        dst = fmt::vformat_to(dst, templates[2], fmt::make_format_args(s.value));
+        const char* name = s.name;
+        return fmt::vformat_to(dst, templates[3], fmt::make_format_args(name));
+    }
+};
+
+// Baseline: every call re-parses the braces
+BENCHMARK_F(RuntimeTemplateFixture, GML_runtime_vformat_to)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = writeVformat(out, samples[idx++ % samples.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Through the cache: one hash lookup on the template pointer and a compare
+// of its text, then replay
+BENCHMARK_F(RuntimeTemplateFixture, GML_runtime_compiled_cache)(benchmark::State& state) {
+    CompiledFormatCache cache;
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        char* pEnd = cache.format(out, templates[0], yesOrNo);
+        pEnd = cache.format(pEnd, templates[1], s.id);
+        pEnd = cache.format(pEnd, templates[2], s.value);
+        pEnd = cache.format(pEnd, templates[3], static_cast<const char*>(s.name));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Compiled formats held by the caller: replay only
+BENCHMARK_F(RuntimeTemplateFixture, GML_runtime_compiled)(benchmark::State& state) {
+    const auto& first = samples.front();
+    const char* firstName = first.name;
+    const CompiledFormat flag(templates[0], fmt::make_format_args("Yes"));
+    const CompiledFormat id(templates[1], fmt::make_format_args(first.id));
+    const CompiledFormat value(templates[2], fmt::make_format_args(first.value));
+    const CompiledFormat name(templates[3], fmt::make_format_args(firstName));
+
+    // Byte-for-byte the same GML as vformat_to
+    for (const auto& s : samples) {
+        char expected[MAX_SAMPLE_SIZE + GML_HEADROOM];
+        const char* expectedEnd = writeVformat(expected, s);
+        char* pEnd = flag.format(out, (s.flag == 0) ? "No" : "Yes");
+        pEnd = id.format(pEnd, s.id);
+        pEnd = value.format(pEnd, s.value);
+        pEnd = name.format(pEnd, static_cast<const char*>(s.name));
+        if (std::string_view(out, pEnd) != std::string_view(expected, expectedEnd)) {
+            state.SkipWithError("compiled format output differs from vformat_to");
+            return;
+        }
+    }
+
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        char* pEnd = flag.format(out, (s.flag == 0) ? "No" : "Yes");
+        pEnd = id.format(pEnd, s.id);
+        pEnd = value.format(pEnd, s.value);
+        pEnd = name.format(pEnd, static_cast<const char*>(s.name));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Ceiling: the same templates known at compile time
+BENCHMARK_F(RuntimeTemplateFixture, GML_FMT_COMPILE)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        char* pEnd = fmt::format_to(out, FMT_COMPILE(";$Flag Value:$ {:s}"), yesOrNo);
+        pEnd = fmt::format_to(pEnd, FMT_COMPILE(";$Launcher ID:$ {}"), s.id);
+        pEnd = fmt::format_to(pEnd, FMT_COMPILE(";$Predicted Intercept Range:$ {:.3f} dm"), s.value);
+        pEnd = fmt::format_to(pEnd, FMT_COMPILE(";$Platform Name:$ {}"), static_cast<const char*>(s.name));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
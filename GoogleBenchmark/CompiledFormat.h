@@ -0,0 +1,198 @@
+#pragma once
+#include "fmt/format.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A format string parsed once at runtime, for templates that only exist at
+// runtime (loaded from configuration) and so cannot use FMT_COMPILE. The
+// braces are parsed into a list of ops (literal runs, plain arguments,
+// arguments with pre-parsed format specs) which formatTo replays against
+// each call's arguments.
+//
+// Spec parsing depends on the argument's type ({:.3f} is valid for a double,
+// not for an int), so compiling takes a sample of the arguments. A later call
+// whose types differ from the sample falls back to fmt::vformat_to, which
+// then formats or reports the error as usual. Custom types keep their spec
+// text and are parsed by their formatter on every call, as in vformat_to.
+class CompiledFormat {
+public:
+    CompiledFormat(const std::string_view format, const fmt::format_args sample) : text(format) {
+        Compiler compiler{ *this, fmt::parse_context<char>(text), sample };
+        fmt::detail::parse_format_string(fmt::string_view(text), compiler);
+    }
+    CompiledFormat(const CompiledFormat&) = delete;
+    CompiledFormat& operator=(const CompiledFormat&) = delete;
+
+    void formatTo(fmt::detail::buffer<char>& buffer, const fmt::format_args args) const {
+        if (!matches(args)) {
+            fmt::detail::vformat_to(buffer, fmt::string_view(text), args);
+            return;
+        }
+        const auto out = fmt::appender(buffer);
+        for (const auto& op : ops) {
+            switch (op.kind) {
+            case Op::Kind::Literal:
+                buffer.append(literals.data() + op.offset, literals.data() + op.offset + op.size);
+                break;
+            case Op::Kind::Arg:
+                args.get(op.arg).visit(fmt::detail::default_arg_formatter<char>{ out });
+                break;
+            case Op::Kind::ArgSpecs:
+                formatWithSpecs(out, args, op);
+                break;
+            case Op::Kind::Custom: {
+                auto parseCtx = fmt::parse_context<char>(fmt::string_view(text.data() + op.offset, text.size() - op.offset));
+                auto ctx = fmt::context(out, args);
+                args.get(op.arg).format_custom(parseCtx.begin(), parseCtx, ctx);
+                break;
+            }
+            }
+        }
+    }
+
+    // Formats at dst and returns the new end, as fmt::format_to(char*, ...)
+    char* formatTo(char* dst, const fmt::format_args args) const {
+        fmt::detail::iterator_buffer<char*, char> buffer(dst);
+        formatTo(buffer, args);
+        return buffer.out();
+    }
+
+    template <typename... T>
+    char* format(char* dst, T&&... args) const {
+        return formatTo(dst, fmt::make_format_args(args...));
+    }
+
+    std::string_view source() const { return text; }
+
+private:
+    struct Op {
+        enum class Kind : uint8_t { Literal, Arg, ArgSpecs, Custom };
+
+        Kind kind;
+        fmt::detail::type type{ fmt::detail::type::none_type };
+        int arg{ 0 };
+        // Literal: the run in literals. Custom: where its specs start in text.
+        uint32_t offset{ 0 };
+        uint32_t size{ 0 };
+        fmt::detail::dynamic_format_specs<char> specs{};
+    };
+
+    // The handler parse_format_string calls back; builds ops instead of output
+    struct Compiler {
+        CompiledFormat& self;
+        fmt::parse_context<char> parseCtx;
+        fmt::format_args sample;
+
+        void on_text(const char* begin, const char* end) {
+            if (begin == end) {
+                return;
+            }
+            auto& ops = self.ops;
+            if (ops.empty() || ops.back().kind != Op::Kind::Literal) {
+                ops.push_back({ Op::Kind::Literal });
+                ops.back().offset = static_cast<uint32_t>(self.literals.size());
+            }
+            self.literals.append(begin, end);
+            ops.back().size += static_cast<uint32_t>(end - begin);
+        }
+
+        int on_arg_id() { return parseCtx.next_arg_id(); }
+        int on_arg_id(const int id) {
+            parseCtx.check_arg_id(id);
+            return id;
+        }
+        int on_arg_id(const fmt::string_view name) {
+            parseCtx.check_arg_id(name);
+            const int id = sample.get_id(name);
+            if (id < 0) {
+                fmt::report_error("argument not found");
+            }
+            return id;
+        }
+
+        void on_replacement_field(const int id, const char*) {
+            self.ops.push_back({ Op::Kind::Arg, sample.get(id).type(), id });
+        }
+
+        const char* on_format_specs(const int id, const char* begin, const char* end) {
+            auto arg = sample.get(id);
+            if (!arg) {
+                fmt::report_error("argument not found");
+            }
+            if (arg.type() == fmt::detail::type::custom_type) {
+                // Run the formatter once on the sample to find where its specs end
+                fmt::memory_buffer scratch;
+                auto ctx = fmt::context(fmt::appender(scratch), sample);
+                arg.format_custom(begin, parseCtx, ctx);
+                self.ops.push_back({ Op::Kind::Custom, arg.type(), id, static_cast<uint32_t>(begin - self.text.data()) });
+                return parseCtx.begin();
+            }
+            Op op{ Op::Kind::ArgSpecs, arg.type(), id };
+            begin = fmt::detail::parse_format_specs(begin, end, op.specs, parseCtx, arg.type());
+            self.ops.push_back(op);
+            return begin;
+        }
+
+        FMT_NORETURN void on_error(const char* message) { fmt::report_error(message); }
+    };
+
+    // Spec'd arguments were parsed for the sample's types and must still match
+    bool matches(const fmt::format_args args) const {
+        for (const auto& op : ops) {
+            if (op.kind >= Op::Kind::ArgSpecs && args.get(op.arg).type() != op.type) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void formatWithSpecs(const fmt::appender out, const fmt::format_args args, const Op& op) {
+        const auto arg = args.get(op.arg);
+        if (!op.specs.dynamic()) {
+            arg.visit(fmt::detail::arg_formatter<char>{ out, op.specs, {} });
+            return;
+        }
+        // Width or precision taken from another argument ({:{}.{}f})
+        auto specs = fmt::format_specs(op.specs);
+        auto ctx = fmt::context(out, args);
+        fmt::detail::handle_dynamic_spec(specs.dynamic_width(), specs.width, op.specs.width_ref, ctx);
+        fmt::detail::handle_dynamic_spec(specs.dynamic_precision(), specs.precision, op.specs.precision_ref, ctx);
+        arg.visit(fmt::detail::arg_formatter<char>{ out, specs, {} });
+    }
+
+    std::string text;
+    std::string literals;
+    std::vector<Op> ops;
+};
+
+// Compiled formats keyed by the template's address, so a lookup never
+// hashes the text. Each template is compiled on first use, with that call's
+// arguments as the sample. Two templates can start at the same address (a
+// prefix of another, or views into one reused buffer), so a hit is checked
+// against the compiled text and the entry compiled again if it differs. Not
+// synchronized: one cache per thread, or fill it at startup.
+class CompiledFormatCache {
+public:
+    const CompiledFormat& get(const std::string_view format, const fmt::format_args sample) {
+        auto& compiled = formats[format.data()];
+        if (!compiled || compiled->source() != format) {
+            compiled = std::make_unique<CompiledFormat>(format, sample);
+        }
+        return *compiled;
+    }
+
+    template <typename... T>
+    char* format(char* dst, const std::string_view format, T&&... args) {
+        const auto store = fmt::make_format_args(args...);
+        return get(format, store).formatTo(dst, store);
+    }
+
+    size_t size() const { return formats.size(); }
+
+private:
+    std::unordered_map<const char*, std::unique_ptr<CompiledFormat>> formats;
+};
@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+#include "Decimal.h"
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "SampleData.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static constexpr size_t DECIMAL_VALUES{ 4'096 };
+
+// Prices as doubles and as Decimal<2> converted once at ingest
+class DecimalPriceFixture : public benchmark::Fixture {
+public:
+    std::vector<double> prices;
+    std::vector<Decimal<2>> decimals;
+    char out[256]{};
+
+    void SetUp(const ::benchmark::State& /*state*/) override {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> cents(1, 9'999'999);
+        prices.resize(DECIMAL_VALUES);
+        decimals.resize(DECIMAL_VALUES);
+        for (size_t i = 0; i < DECIMAL_VALUES; ++i) {
+            prices[i] = cents(rng) / 100.0;
+            decimals[i] = Decimal<2>::fromDouble(prices[i]);
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        prices.clear();
+        decimals.clear();
+    }
+};
+
+BENCHMARK_F(DecimalPriceFixture, BM_Price_fmt_double)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = fmt::format_to(out, "${:.2f}", prices[idx++ % prices.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_F(DecimalPriceFixture, BM_Price_fmt_decimal)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = fmt::format_to(out, "${}", decimals[idx++ % decimals.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_F(DecimalPriceFixture, BM_Price_write_decimal)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        out[0] = '$';
+        char* pEnd = writeDecimal(out + 1, decimals[idx++ % decimals.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+// The whole Product/ID/Price string, as in BM_StdFormat
+static void BM_StringFormat_Decimal(benchmark::State& state) {
+    int id = 12345;
+    const auto price = Decimal<2>::fromDouble(99.99);
+    const char* name = "Widget";
+
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string result = fmt::format("Product: {}, ID: {}, Price: ${}", name, id, price);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_StringFormat_Decimal);
+
+static void BM_StringFormat_Double(benchmark::State& state) {
+    int id = 12345;
+    double price = 99.99;
+    const char* name = "Widget";
+
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string result = fmt::format("Product: {}, ID: {}, Price: ${:.2f}", name, id, price);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_StringFormat_Double);
+
+// GML range field: writeValue on the double versus the same fragment from a
+// Decimal<3>, converted at ingest (SetUp) or per record
+class DecimalRangeFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    std::vector<Decimal<3>> ranges;
+    char out[MAX_VALUE_SIZE + GML_HEADROOM]{};
+
+    void SetUp(const ::benchmark::State& /*state*/) override {
+        samples = makeSamples(DECIMAL_VALUES);
+        ranges.resize(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            ranges[i] = Decimal<3>::fromDouble(samples[i].value);
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+        ranges.clear();
+    }
+};
+
+static char* writeRange(char* dst, const Decimal<3> range) {
+    std::memcpy(dst, VALUE_LABEL.data(), VALUE_LABEL.size());
+    dst = writeDecimal(dst + VALUE_LABEL.size(), range);
+    std::memcpy(dst, VALUE_UNITS.data(), VALUE_UNITS.size());
+    return dst + VALUE_UNITS.size();
+}
+
+BENCHMARK_F(DecimalRangeFixture, GML_range_fmt_double)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = writeValue(out, samples[idx++ % samples.size()].value);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_F(DecimalRangeFixture, GML_range_fmt_decimal)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = fmt::format_to(out, ";$Predicted Intercept Range:$ {} dm", ranges[idx++ % ranges.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_F(DecimalRangeFixture, GML_range_write_decimal)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        char* pEnd = writeRange(out, ranges[idx++ % ranges.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_F(DecimalRangeFixture, GML_range_write_decimal_convert)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        char* pEnd = writeRange(out, Decimal<3>::fromDouble(samples[idx++ % samples.size()].value));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "Digits.h"
+#include "fmt/format.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Fixed-point decimal: an int64 count of 10^-Scale units, e.g. Decimal<2>
+// for prices in cents and Decimal<3> for ranges in thousandths. Printing is
+// integer-only (digit pairs), so a value with a fixed number of decimals
+// never goes through floating-point formatting.
+//
+// fromDouble rounds once, at ingest, half away from zero. For a double
+// within an ulp of a rounding tie the last digit can differ from "{:.Nf}" of
+// the original double, and a negative value that rounds to zero prints
+// without the sign ("0.000", not "-0.000").
+template <int Scale>
+class Decimal {
+    static_assert(Scale >= 0 && Scale <= 18, "the scale factor must fit in int64");
+
+public:
+    static constexpr int64_t SCALE_FACTOR = [] {
+        int64_t factor = 1;
+        for (int i = 0; i < Scale; ++i) {
+            factor *= 10;
+        }
+        return factor;
+    }();
+
+    constexpr Decimal() = default;
+
+    static constexpr Decimal fromMantissa(const int64_t mantissa) { return Decimal(mantissa); }
+
+    // value * 10^Scale must fit in int64
+    static Decimal fromDouble(const double value) {
+        return Decimal(std::llround(value * static_cast<double>(SCALE_FACTOR)));
+    }
+
+    constexpr int64_t mantissa() const { return units; }
+    double toDouble() const { return static_cast<double>(units) / static_cast<double>(SCALE_FACTOR); }
+
+    constexpr bool operator==(const Decimal&) const = default;
+
+private:
+    constexpr explicit Decimal(const int64_t mantissa) : units(mantissa) {}
+
+    int64_t units{ 0 };
+};
+
+// Decimal digits of a uint64
+inline int countDigits64(const uint64_t n) {
+    static constexpr uint64_t POWERS_OF_10[] = {
+        0, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000,
+        10'000'000'000, 100'000'000'000, 1'000'000'000'000, 10'000'000'000'000, 100'000'000'000'000,
+        1'000'000'000'000'000, 10'000'000'000'000'000, 100'000'000'000'000'000,
+        1'000'000'000'000'000'000, 10'000'000'000'000'000'000u
+    };
+    const int t = (std::bit_width(n | 1) * 1233) >> 12;
+    return t - (n < POWERS_OF_10[t] ? 1 : 0) + 1;
+}
+
+// Writes exactly `digits` digits of n (zero-padded) ending at end, two at a
+// time from the right
+inline void writeDigitPairs(char* end, uint64_t n, int digits) {
+    for (; digits >= 2; digits -= 2) {
+        end -= 2;
+        std::memcpy(end, DIGIT_PAIRS + (n % 100) * 2, 2);
+        n /= 100;
+    }
+    if (digits == 1) {
+        *--end = static_cast<char>('0' + n);
+    }
+}
+
+// Longest text of a Decimal: sign, 19 digits and the point
+inline constexpr size_t MAX_DECIMAL_CHARS{ 21 };
+
+// Same text as "{:.<Scale>f}" of the decimal's exact value; returns the new end
+template <int Scale>
+char* writeDecimal(char* dst, const Decimal<Scale> value) {
+    const int64_t units = value.mantissa();
+    if (units < 0) {
+        *dst++ = '-';
+    }
+    const uint64_t n = units < 0 ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+    const uint64_t integer = n / Decimal<Scale>::SCALE_FACTOR;
+    const int integerDigits = countDigits64(integer);
+    writeDigitPairs(dst + integerDigits, integer, integerDigits);
+    dst += integerDigits;
+    if constexpr (Scale > 0) {
+        *dst++ = '.';
+        writeDigitPairs(dst + Scale, n % Decimal<Scale>::SCALE_FACTOR, Scale);
+        dst += Scale;
+    }
+    return dst;
+}
+
+// Formats through writeDecimal; width, fill and alignment work as for strings
+template <int Scale>
+struct fmt::formatter<Decimal<Scale>> : fmt::formatter<fmt::string_view> {
+    auto format(const Decimal<Scale>& value, fmt::format_context& ctx) const {
+        char text[MAX_DECIMAL_CHARS];
+        const char* end = writeDecimal(text, value);
+        return fmt::formatter<fmt::string_view>::format({ text, static_cast<size_t>(end - text) }, ctx);
+    }
+};
@@ -1,26 +1,12 @@
 #include <benchmark/benchmark.h>
+#include "DecodeEnum.h"
+#include "Simd.h"
 #include <string>
 #include <array>
 #include <unordered_map>
 #include <random>
-
-// Example enum
-enum class StatusCode {
-    Success = 57,
-    InvalidInput = 58,
-    NotFound = 59,
-    Unauthorized = 60,
-    ServerError = 61,
-    Timeout = 62,
-    RateLimited = 63,
-    BadRequest = 64,
-    Forbidden = 65,
-    Conflict = 66
-};
-
-static constexpr int MIN_STATUS = 57;
-static constexpr int MAX_STATUS = 66;
-static constexpr int STATUS_OFFSET = static_cast<int>(StatusCode::Success);
+#include <algorithm>
+#include <vector>
 
 // Method 1: Switch statement
 const char* DecodeSwitch(const int code) {
@@ -55,20 +41,7 @@ const char* DecodeCastSwitch(const int code) {
     }
 }
 
-// Method 2: Array lookup (fastest for contiguous values)
-static constexpr std::array<const char*, 10> STATUS_NAMES = {
-    "Success",
-    "InvalidInput",
-    "NotFound",
-    "Unauthorized",
-    "ServerError",
-    "Timeout",
-    "RateLimited",
-    "BadRequest",
-    "Forbidden",
-    "Conflict"
-};
-
+// Method 2: Array lookup over STATUS_NAMES (fastest for contiguous values)
 const char* DecodeArray(const int code) {
     if (const int index = code - STATUS_OFFSET; index >= 0 && index < static_cast<int>(STATUS_NAMES.size())) {
         return STATUS_NAMES[index];
@@ -135,6 +108,115 @@ const char* DecodeIfElse(int code) {
     else return "Unknown";
 }
 
+// Method 5: Batch decode. Out-of-range codes map to the extra "Unknown"
+// slot: code - offset as unsigned wraps negatives to huge values, so one
+// unsigned min clamps both ends of the range.
+static constexpr std::array<const char*, STATUS_NAMES.size() + 1> STATUS_NAMES_OR_UNKNOWN = [] {
+    std::array<const char*, STATUS_NAMES.size() + 1> names{};
+    for (size_t i = 0; i < STATUS_NAMES.size(); ++i) {
+        names[i] = STATUS_NAMES[i];
+    }
+    names[STATUS_NAMES.size()] = "Unknown";
+    return names;
+}();
+static constexpr unsigned UNKNOWN_INDEX = static_cast<unsigned>(STATUS_NAMES.size());
+
+void DecodeBatchScalar(const int* codes, const char** names, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned index = static_cast<unsigned>(codes[i]) - static_cast<unsigned>(STATUS_OFFSET);
+        names[i] = STATUS_NAMES_OR_UNKNOWN[std::min(index, UNKNOWN_INDEX)];
+    }
+}
+
+#if GML_X86
+// Four indexes per step; the table loads stay scalar (no gather before AVX2)
+GML_TARGET("sse4.1")
+void DecodeBatchSse41(const int* codes, const char** names, const size_t count) {
+    const __m128i offset = _mm_set1_epi32(STATUS_OFFSET);
+    const __m128i unknown = _mm_set1_epi32(static_cast<int>(UNKNOWN_INDEX));
+    alignas(16) uint32_t indexes[4];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i));
+        _mm_store_si128(reinterpret_cast<__m128i*>(indexes), _mm_min_epu32(_mm_sub_epi32(v, offset), unknown));
+        names[i] = STATUS_NAMES_OR_UNKNOWN[indexes[0]];
+        names[i + 1] = STATUS_NAMES_OR_UNKNOWN[indexes[1]];
+        names[i + 2] = STATUS_NAMES_OR_UNKNOWN[indexes[2]];
+        names[i + 3] = STATUS_NAMES_OR_UNKNOWN[indexes[3]];
+    }
+    DecodeBatchScalar(codes + i, names + i, count - i);
+}
+
+// Eight indexes per step, pointers fetched with gathers
+GML_TARGET("avx2")
+void DecodeBatchAvx2(const int* codes, const char** names, const size_t count) {
+    const __m256i offset = _mm256_set1_epi32(STATUS_OFFSET);
+    const __m256i unknown = _mm256_set1_epi32(static_cast<int>(UNKNOWN_INDEX));
+    const auto* table = reinterpret_cast<const void*>(STATUS_NAMES_OR_UNKNOWN.data());
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i));
+        const __m256i indexes = _mm256_min_epu32(_mm256_sub_epi32(v, offset), unknown);
+#if GML_X64
+        const __m256i low = _mm256_i32gather_epi64(static_cast<const long long*>(table),
+            _mm256_castsi256_si128(indexes), 8);
+        const __m256i high = _mm256_i32gather_epi64(static_cast<const long long*>(table),
+            _mm256_extracti128_si256(indexes, 1), 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(names + i), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(names + i + 4), high);
+#else
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(names + i),
+            _mm256_i32gather_epi32(static_cast<const int*>(table), indexes, 4));
+#endif
+    }
+    DecodeBatchSse41(codes + i, names + i, count - i);
+}
+
+// Sixteen indexes per step
+GML_TARGET(GML_AVX512)
+void DecodeBatchAvx512(const int* codes, const char** names, const size_t count) {
+    const __m512i offset = _mm512_set1_epi32(STATUS_OFFSET);
+    const __m512i unknown = _mm512_set1_epi32(static_cast<int>(UNKNOWN_INDEX));
+    const auto* table = reinterpret_cast<const void*>(STATUS_NAMES_OR_UNKNOWN.data());
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i v = _mm512_loadu_si512(codes + i);
+        const __m512i indexes = _mm512_min_epu32(_mm512_sub_epi32(v, offset), unknown);
+#if GML_X64
+        const __m512i low = _mm512_i32gather_epi64(_mm512_castsi512_si256(indexes), table, 8);
+        const __m512i high = _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(indexes, 1), table, 8);
+        _mm512_storeu_si512(names + i, low);
+        _mm512_storeu_si512(names + i + 8, high);
+#else
+        _mm512_storeu_si512(names + i, _mm512_i32gather_epi32(indexes, table, 4));
+#endif
+    }
+    DecodeBatchAvx2(codes + i, names + i, count - i);
+}
+#else
+void DecodeBatchSse41(const int* codes, const char** names, const size_t count) {
+    DecodeBatchScalar(codes, names, count);
+}
+void DecodeBatchAvx2(const int* codes, const char** names, const size_t count) {
+    DecodeBatchScalar(codes, names, count);
+}
+void DecodeBatchAvx512(const int* codes, const char** names, const size_t count) {
+    DecodeBatchScalar(codes, names, count);
+}
+#endif
+
+using DecodeBatchKernel = void (*)(const int* codes, const char** names, size_t count);
+
+void DecodeBatch(const int* codes, const char** names, const size_t count) {
+    static const DecodeBatchKernel kernel = selectKernel<DecodeBatchKernel>({
+        { IsaLevel::Avx512, DecodeBatchAvx512 },
+        { IsaLevel::Avx2, DecodeBatchAvx2 },
+        { IsaLevel::Sse41, DecodeBatchSse41 },
+        { IsaLevel::Scalar, DecodeBatchScalar },
+    });
+    kernel(codes, names, count);
+}
+
 // Fixture to generate random test data
 class EnumDecodeFixture : public benchmark::Fixture {
 public:
@@ -222,6 +304,51 @@ BENCHMARK_F(EnumDecodeFixture, DE_DecodeIfElse)(benchmark::State& state) {
     }
 }
 
+// Benchmark: Batch decode of the whole code array per iteration, through the
+// dispatcher and through each kernel
+static void decodeBatch(benchmark::State& state, const std::vector<int>& codes, const DecodeBatchKernel kernel) {
+    std::vector<const char*> names(codes.size());
+    for (auto _ : state) {
+        kernel(codes.data(), names.data(), codes.size());
+        benchmark::DoNotOptimize(names.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(codes.size()));
+}
+
+BENCHMARK_F(EnumDecodeFixture, DE_DecodeBatch)(benchmark::State& state) {
+    state.SetLabel(std::string(isaLevelName(activeIsaLevel())));
+    decodeBatch(state, random_codes, DecodeBatch);
+}
+
+BENCHMARK_F(EnumDecodeFixture, DE_DecodeBatch_Scalar)(benchmark::State& state) {
+    decodeBatch(state, random_codes, DecodeBatchScalar);
+}
+
+BENCHMARK_F(EnumDecodeFixture, DE_DecodeBatch_Sse41)(benchmark::State& state) {
+    if (!cpuSupports(IsaLevel::Sse41)) {
+        state.SkipWithError("SSE4.1 not supported on this CPU");
+        return;
+    }
+    decodeBatch(state, random_codes, DecodeBatchSse41);
+}
+
+BENCHMARK_F(EnumDecodeFixture, DE_DecodeBatch_Avx2)(benchmark::State& state) {
+    if (!cpuSupports(IsaLevel::Avx2)) {
+        state.SkipWithError("AVX2 not supported on this CPU");
+        return;
+    }
+    decodeBatch(state, random_codes, DecodeBatchAvx2);
+}
+
+BENCHMARK_F(EnumDecodeFixture, DE_DecodeBatch_Avx512)(benchmark::State& state) {
+    if (!cpuSupports(IsaLevel::Avx512)) {
+        state.SkipWithError("AVX-512 not supported on this CPU");
+        return;
+    }
+    decodeBatch(state, random_codes, DecodeBatchAvx512);
+}
+
 // Bonus: Test with edge cases (including invalid values)
 static void DE_DecodeSwitch_WithInvalid(benchmark::State& state) {
     std::mt19937 rng(42);
@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+// Example enum
+enum class StatusCode {
+    Success = 57,
+    InvalidInput = 58,
+    NotFound = 59,
+    Unauthorized = 60,
+    ServerError = 61,
+    Timeout = 62,
+    RateLimited = 63,
+    BadRequest = 64,
+    Forbidden = 65,
+    Conflict = 66
+};
+
+static constexpr int MIN_STATUS = 57;
+static constexpr int MAX_STATUS = 66;
+static constexpr int STATUS_OFFSET = static_cast<int>(StatusCode::Success);
+
+static constexpr std::array<const char*, 10> STATUS_NAMES = {
+    "Success",
+    "InvalidInput",
+    "NotFound",
+    "Unauthorized",
+    "ServerError",
+    "Timeout",
+    "RateLimited",
+    "BadRequest",
+    "Forbidden",
+    "Conflict"
+};
+
+const char* DecodeSwitch(const int code);
+const char* DecodeCastSwitch(const int code);
+const char* DecodeArray(const int code);
+const char* DecodeCArray(const int code);
+const char* DecodeHashMap(int code);
+const char* DecodeIfElse(int code);
+
+// Batch decode: names[i] = DecodeArray(codes[i]), using the widest kernel
+// the active ISA level allows
+void DecodeBatch(const int* codes, const char** names, size_t count);
+void DecodeBatchScalar(const int* codes, const char** names, size_t count);
+void DecodeBatchSse41(const int* codes, const char** names, size_t count);
+void DecodeBatchAvx2(const int* codes, const char** names, size_t count);
+void DecodeBatchAvx512(const int* codes, const char** names, size_t count);
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "SampleData.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+// An already-rendered GML field fragment, kept between emissions
+template <size_t N>
+struct Fragment {
+    uint16_t size{ 0 };
+    char data[N];
+
+    char* appendTo(char* dst) const {
+        std::memcpy(dst, data, size);
+        return dst + size;
+    }
+};
+
+template <size_t N>
+static void setFragment(Fragment<N>& fragment, const char* end) {
+    fragment.size = static_cast<uint16_t>(end - fragment.data);
+}
+
+// Incremental encoder: remembers the last emitted bytes of every record slot
+// and only re-formats the fields whose bytes changed since then. Unchanged
+// fields are spliced into the output straight from the fragment cache.
+class DeltaEncoder {
+public:
+    explicit DeltaEncoder(const size_t recordCount) : records(recordCount) {}
+
+    char* encode(char* dst, const size_t index, const Sample_t& sample) {
+        auto& rec = records[index];
+        if (!rec.valid || rec.last.flag != sample.flag) {
+            rec.last.flag = sample.flag;
+            setFragment(rec.flag, writeFlag(rec.flag.data, sample.flag));
+        }
+        if (!rec.valid || rec.last.id != sample.id) {
+            rec.last.id = sample.id;
+            setFragment(rec.id, writeId(rec.id.data, sample.id));
+        }
+        // Compare bit patterns, not values, so -0.0 and NaN payloads re-render
+        if (!rec.valid || std::memcmp(&rec.last.value, &sample.value, sizeof(sample.value)) != 0) {
+            rec.last.value = sample.value;
+            setFragment(rec.value, writeValue(rec.value.data, sample.value));
+        }
+        if (!rec.valid || strncmp(rec.last.name, sample.name, sizeof(sample.name)) != 0) {
+            std::memcpy(rec.last.name, sample.name, sizeof(sample.name));
+            setFragment(rec.name, writeNameBounded(rec.name.data, sample.name));
+        }
+        rec.valid = true;
+
+        dst = rec.flag.appendTo(dst);
+        dst = rec.id.appendTo(dst);
+        dst = rec.value.appendTo(dst);
+        return rec.name.appendTo(dst);
+    }
+
+private:
+    struct CachedRecord {
+        bool valid{ false };
+        Sample_t last{};
+        Fragment<MAX_FLAG_SIZE> flag;
+        Fragment<MAX_ID_SIZE> id;
+        Fragment<MAX_VALUE_SIZE> value;
+        Fragment<MAX_NAME_SIZE> name;
+    };
+    std::vector<CachedRecord> records;
+};
+
+static constexpr size_t DELTA_RECORDS{ 1'000 };
+static constexpr size_t DELTA_CYCLES{ 64 };
+
+enum ChangeBits : uint8_t {
+    CHANGE_FLAG = 1,
+    CHANGE_ID = 2,
+    CHANGE_VALUE = 4,
+    CHANGE_NAME = 8
+};
+
+// Each record field changes independently with probability changePercent / 100
+// in every cycle. Changes are toggles so the records never drift in length.
+class DeltaEncodeFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    std::vector<uint8_t> changes;  // DELTA_CYCLES x DELTA_RECORDS masks
+    std::vector<char> out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        samples = makeSamples(DELTA_RECORDS);
+        out.assign(DELTA_RECORDS * MAX_SAMPLE_SIZE + GML_HEADROOM, '\0');
+
+        std::mt19937 rng(42);
+        std::bernoulli_distribution changed(static_cast<double>(state.range(0)) / 100.0);
+        changes.resize(DELTA_CYCLES * DELTA_RECORDS);
+        for (auto& mask : changes) {
+            mask = 0;
+            for (const uint8_t bit : { CHANGE_FLAG, CHANGE_ID, CHANGE_VALUE, CHANGE_NAME }) {
+                if (changed(rng)) {
+                    mask |= bit;
+                }
+            }
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+        changes.clear();
+        out.clear();
+    }
+
+    void applyCycle(const size_t cycle) {
+        const uint8_t* mask = changes.data() + (cycle % DELTA_CYCLES) * DELTA_RECORDS;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            auto& s = samples[i];
+            if (mask[i] & CHANGE_FLAG) s.flag ^= 1;
+            if (mask[i] & CHANGE_ID) s.id ^= 1;
+            if (mask[i] & CHANGE_VALUE) s.value = -s.value;
+            if (mask[i] & CHANGE_NAME) s.name[0] ^= 0x20;  // Toggle case
+        }
+    }
+};
+
+// Baseline: every record is fully re-formatted every cycle
+BENCHMARK_DEFINE_F(DeltaEncodeFixture, GML_fmt_format_to_Cycle)(benchmark::State& state) {
+    size_t cycle = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        applyCycle(cycle++);
+        state.ResumeTiming();
+        char* pEnd = out.data();
+        for (const auto& s : samples) {
+            pEnd = writeSample(pEnd, s);
+        }
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * DELTA_RECORDS);
+}
+BENCHMARK_REGISTER_F(DeltaEncodeFixture, GML_fmt_format_to_Cycle)
+    ->ArgName("change%")->Arg(0)->Arg(10)->Arg(50)->Arg(100);
+
+BENCHMARK_DEFINE_F(DeltaEncodeFixture, GML_delta_encode)(benchmark::State& state) {
+    DeltaEncoder encoder(DELTA_RECORDS);
+    // Prime the cache so we measure the steady state, not the first emission
+    for (size_t i = 0; i < samples.size(); ++i) {
+        encoder.encode(out.data(), i, samples[i]);
+    }
+    size_t cycle = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        applyCycle(cycle++);
+        state.ResumeTiming();
+        char* pEnd = out.data();
+        for (size_t i = 0; i < samples.size(); ++i) {
+            pEnd = encoder.encode(pEnd, i, samples[i]);
+        }
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * DELTA_RECORDS);
+}
+BENCHMARK_REGISTER_F(DeltaEncodeFixture, GML_delta_encode)
+    ->ArgName("change%")->Arg(0)->Arg(10)->Arg(50)->Arg(100);
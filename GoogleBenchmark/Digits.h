@@ -0,0 +1,280 @@
+#pragma once
+#include "Simd.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+// Decimal text of an int, right-aligned in a 16-byte slot so writers can copy
+// it with one fixed-size memcpy from text + offset. The copy runs past the
+// slot, so slot arrays carry one spare slot at the end.
+struct DigitSlot {
+    char text[16];
+    uint8_t offset;  // Index of the first character (sign or digit)
+    uint8_t size;    // Characters from offset to the end of text
+    char* copyTo(char* dst) const {
+        std::memcpy(dst, text + offset, 16);
+        return dst + size;
+    }
+};
+
+static constexpr char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Number of decimal digits: log10 estimated from the bit width, then fixed up
+inline int countDigits(const uint32_t n) {
+    static constexpr uint32_t POWERS_OF_10[] = {
+        0, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000
+    };
+    const int t = (std::bit_width(n | 1) * 1233) >> 12;
+    return t - (n < POWERS_OF_10[t] ? 1 : 0) + 1;
+}
+
+inline void setSign(DigitSlot& slot, const bool negative, const int digits) {
+    slot.offset = static_cast<uint8_t>(16 - digits - (negative ? 1 : 0));
+    slot.size = static_cast<uint8_t>(16 - slot.offset);
+    if (negative) {
+        slot.text[slot.offset] = '-';
+    }
+}
+
+// Scalar reference: digit pairs written from the right
+inline void toDigitsScalar(DigitSlot& slot, const int value) {
+    const bool negative = value < 0;
+    uint32_t n = negative ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    const int digits = countDigits(n);
+    char* p = slot.text + 16;
+    while (n >= 100) {
+        p -= 2;
+        std::memcpy(p, DIGIT_PAIRS + (n % 100) * 2, 2);
+        n /= 100;
+    }
+    if (n >= 10) {
+        p -= 2;
+        std::memcpy(p, DIGIT_PAIRS + n * 2, 2);
+    } else {
+        *--p = static_cast<char>('0' + n);
+    }
+    setSign(slot, negative, digits);
+}
+
+#if GML_X86
+// Eight decimal digits of n < 10^8 as ASCII in the low 8 bytes, using the
+// SSE2 divide-by-multiply scheme from Wojciech Mula's itoa work: split into
+// two 4-digit halves, then divide each lane by 1000/100/10/1 with mulhi.
+inline __m128i eightDigitsSse2(const uint32_t n) {
+    const __m128i div10000 = _mm_set1_epi32(static_cast<int>(0xd1b71759));
+    const __m128i mul10000 = _mm_set1_epi32(10000);
+    const __m128i divPowers = _mm_setr_epi16(8389, 5243, 13108, static_cast<short>(32768),
+        8389, 5243, 13108, static_cast<short>(32768));
+    const __m128i shiftPowers = _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, static_cast<short>(1 << 15),
+        1 << 7, 1 << 11, 1 << 13, static_cast<short>(1 << 15));
+    const __m128i ten = _mm_set1_epi16(10);
+
+    const __m128i abcdefgh = _mm_cvtsi32_si128(static_cast<int>(n));
+    const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, div10000), 45);
+    const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, mul10000));
+    // [abcd*4 x4, efgh*4 x4]
+    const __m128i v1 = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    const __m128i v2a = _mm_unpacklo_epi16(v1, v1);
+    const __m128i v2 = _mm_unpacklo_epi32(v2a, v2a);
+    // [a, ab, abc, abcd, e, ef, efg, efgh]
+    const __m128i v4 = _mm_mulhi_epu16(_mm_mulhi_epu16(v2, divPowers), shiftPowers);
+    // [a, b, c, d, e, f, g, h]
+    const __m128i v7 = _mm_sub_epi16(v4, _mm_slli_epi64(_mm_mullo_epi16(v4, ten), 16));
+    return _mm_add_epi8(_mm_packus_epi16(v7, _mm_setzero_si128()), _mm_set1_epi8('0'));
+}
+
+// The low eight digits come from one SSE2 conversion; the top two (2^31 has
+// ten digits) from the pair table.
+inline void toDigitsSse2(DigitSlot& slot, const int value) {
+    const bool negative = value < 0;
+    const uint32_t n = negative ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    const uint32_t high = n / 100'000'000;
+    const uint32_t low = n % 100'000'000;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(slot.text + 8), eightDigitsSse2(low));
+    std::memcpy(slot.text + 6, DIGIT_PAIRS + high * 2, 2);
+    setSign(slot, negative, countDigits(n));
+}
+
+// Sixteen values at a time with AVX-512. Lanes split |v| into the top two
+// digits and the low eight like toDigitsSse2, spread each 4-digit half over
+// four 16-bit lanes for the same mulhi digit split, and pack to bytes. The
+// digit count comes from nine unsigned compares against powers of ten.
+struct DigitsX16 {
+    __m512i low01;   // Low eight digits; 128-bit lane L holds value L, then value L + 4
+    __m512i low23;   // Same for values 8-15
+    __m512i high;    // 32-bit lane j: top digit pair of value j in bytes 0-1, then "00"
+    __m512i offset;  // 32-bit lane j: DigitSlot::offset of value j
+    __mmask16 negative;
+};
+
+// Source 16-bit lane for each lane of a 4-value group: [abcd x4, efgh x4] per value
+inline constexpr uint16_t DIGIT_SPREAD[32] = {
+    0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+    4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7
+};
+
+// (n * magic) >> Shift per 32-bit lane; even and odd lanes multiply separately
+template <int Shift>
+GML_TARGET(GML_AVX512) inline __m512i divideEvenOdd(const __m512i n, const __m512i magic) {
+    const __m512i even = _mm512_srli_epi64(_mm512_mul_epu32(n, magic), Shift);
+    const __m512i odd = _mm512_srli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(n, 32), magic), Shift);
+    return _mm512_or_si512(even, _mm512_slli_epi64(odd, 32));
+}
+
+GML_TARGET(GML_AVX512) inline __m512i fourDigitGroupAvx512(const __m512i halves, const int group) {
+    const __m512i divPowers = _mm512_set1_epi64(static_cast<long long>(0x8000'3334'147b'20c5));  // 8389, 5243, 13108, 32768
+    const __m512i shiftPowers = _mm512_set1_epi64(static_cast<long long>(0x8000'2000'0800'0080));  // 1 << 7, 11, 13, 15
+    const __m512i spread = _mm512_add_epi16(_mm512_loadu_si512(DIGIT_SPREAD), _mm512_set1_epi16(static_cast<short>(8 * group)));
+    // Each half times 4, as in eightDigitsSse2
+    const __m512i v2 = _mm512_slli_epi16(_mm512_permutexvar_epi16(spread, halves), 2);
+    const __m512i v4 = _mm512_mulhi_epu16(_mm512_mulhi_epu16(v2, divPowers), shiftPowers);
+    return _mm512_sub_epi16(v4, _mm512_slli_epi64(_mm512_mullo_epi16(v4, _mm512_set1_epi16(10)), 16));
+}
+
+GML_TARGET(GML_AVX512) inline DigitsX16 digitsX16Avx512(const int* values) {
+    const __m512i v = _mm512_loadu_si512(values);
+    const __m512i n = _mm512_abs_epi32(v);  // abs(INT_MIN) is 2^31 as unsigned
+    // ceil(2^58 / 10^8) and ceil(2^45 / 10^4): exact for n <= 2^31 and n < 10^8
+    const __m512i high = divideEvenOdd<58>(n, _mm512_set1_epi64(2'882'303'762));
+    const __m512i low = _mm512_sub_epi32(n, _mm512_mullo_epi32(high, _mm512_set1_epi32(100'000'000)));
+    const __m512i abcd = divideEvenOdd<45>(low, _mm512_set1_epi64(0xd1b71759));
+    const __m512i efgh = _mm512_sub_epi32(low, _mm512_mullo_epi32(abcd, _mm512_set1_epi32(10'000)));
+    const __m512i halves = _mm512_or_si512(abcd, _mm512_slli_epi32(efgh, 16));
+
+    const __m512i zero = _mm512_set1_epi8('0');
+    DigitsX16 d;
+    d.low01 = _mm512_add_epi8(_mm512_packus_epi16(fourDigitGroupAvx512(halves, 0), fourDigitGroupAvx512(halves, 1)), zero);
+    d.low23 = _mm512_add_epi8(_mm512_packus_epi16(fourDigitGroupAvx512(halves, 2), fourDigitGroupAvx512(halves, 3)), zero);
+
+    const __m512i tens = _mm512_srli_epi32(_mm512_mullo_epi32(high, _mm512_set1_epi32(103)), 10);
+    const __m512i ones = _mm512_sub_epi32(high, _mm512_mullo_epi32(tens, _mm512_set1_epi32(10)));
+    d.high = _mm512_add_epi8(_mm512_or_si512(tens, _mm512_slli_epi32(ones, 8)), zero);
+
+    __m512i digits = _mm512_set1_epi32(1);
+    uint32_t power = 1;
+    for (int i = 1; i < 10; ++i) {
+        power *= 10;
+        const __mmask16 more = _mm512_cmpge_epu32_mask(n, _mm512_set1_epi32(static_cast<int>(power)));
+        digits = _mm512_mask_add_epi32(digits, more, digits, _mm512_set1_epi32(1));
+    }
+    d.negative = _mm512_cmplt_epi32_mask(v, _mm512_setzero_si512());
+    const __m512i offset = _mm512_sub_epi32(_mm512_set1_epi32(16), digits);
+    d.offset = _mm512_mask_sub_epi32(offset, d.negative, offset, _mm512_set1_epi32(1));
+    return d;
+}
+
+// Byte offset of value j's low digits in DigitsX16::low01/low23
+constexpr size_t lowDigitsAt(const size_t j) {
+    return 64 * (j / 8) + 16 * (j % 4) + 8 * (j / 4 % 2);
+}
+
+// AVX-512BW: the vector part runs sixteen wide; the pieces are then copied
+// into each slot
+GML_TARGET(GML_AVX512) inline void toDigitsX16Avx512(DigitSlot* slots, const int* values) {
+    const DigitsX16 d = digitsX16Avx512(values);
+    alignas(64) char low[128];
+    alignas(64) uint32_t high[16];
+    alignas(64) uint32_t offsets[16];
+    _mm512_store_si512(low, d.low01);
+    _mm512_store_si512(low + 64, d.low23);
+    _mm512_store_si512(high, d.high);
+    _mm512_store_si512(offsets, d.offset);
+    for (size_t j = 0; j < 16; ++j) {
+        auto& slot = slots[j];
+        std::memcpy(slot.text + 8, low + lowDigitsAt(j), 8);
+        std::memcpy(slot.text + 6, &high[j], 2);
+        slot.offset = static_cast<uint8_t>(offsets[j]);
+        slot.size = static_cast<uint8_t>(16 - offsets[j]);
+        if ((d.negative >> j) & 1) {
+            slot.text[slot.offset] = '-';
+        }
+    }
+}
+
+// permutex2var indexes that build whole 16-byte slot images, four per group
+// of values: low digits from low01/low23 (0-63), the top pair and '0' padding
+// from high (64-127)
+inline constexpr auto SLOT_IMAGE_INDEX = [] {
+    std::array<std::array<uint8_t, 64>, 4> index{};
+    for (size_t group = 0; group < 4; ++group) {
+        for (size_t b = 0; b < 64; ++b) {
+            const size_t j = 4 * group + b / 16;
+            const size_t pos = b % 16;
+            if (pos >= 8) {
+                index[group][b] = static_cast<uint8_t>(lowDigitsAt(j) % 64 + pos - 8);
+            } else {
+                index[group][b] = static_cast<uint8_t>(64 + 4 * j + (pos >= 6 ? pos - 6 : 2));
+            }
+        }
+    }
+    return index;
+}();
+
+// permutexvar indexes that broadcast each value's 32-bit lane byte 0 over its slot
+inline constexpr auto SLOT_OWNER_INDEX = [] {
+    std::array<std::array<uint8_t, 64>, 4> index{};
+    for (size_t group = 0; group < 4; ++group) {
+        for (size_t b = 0; b < 64; ++b) {
+            index[group][b] = static_cast<uint8_t>(4 * (4 * group + b / 16));
+        }
+    }
+    return index;
+}();
+
+inline constexpr uint8_t SLOT_POSITIONS[64] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+
+// AVX-512VBMI: byte permutes assemble finished slot images in registers,
+// sign included ('-' fills every byte up to the offset), so each slot takes
+// one 16-byte store
+GML_TARGET(GML_AVX512_VBMI) inline void toDigitsX16Avx512Vbmi(DigitSlot* slots, const int* values) {
+    const DigitsX16 d = digitsX16Avx512(values);
+    const __m512i signEnd = _mm512_maskz_add_epi32(d.negative, d.offset, _mm512_set1_epi32(1));
+    const __m512i positions = _mm512_loadu_si512(SLOT_POSITIONS);
+    const __m512i minus = _mm512_set1_epi8('-');
+    alignas(64) uint32_t offsets[16];
+    _mm512_store_si512(offsets, d.offset);
+    for (size_t group = 0; group < 4; ++group) {
+        const __m512i low = group < 2 ? d.low01 : d.low23;
+        __m512i image = _mm512_permutex2var_epi8(low, _mm512_loadu_si512(SLOT_IMAGE_INDEX[group].data()), d.high);
+        const __m512i signBytes = _mm512_permutexvar_epi8(_mm512_loadu_si512(SLOT_OWNER_INDEX[group].data()), signEnd);
+        image = _mm512_mask_mov_epi8(image, _mm512_cmplt_epu8_mask(positions, signBytes), minus);
+        DigitSlot* out = slots + 4 * group;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[0].text), _mm512_extracti32x4_epi32(image, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[1].text), _mm512_extracti32x4_epi32(image, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[2].text), _mm512_extracti32x4_epi32(image, 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[3].text), _mm512_extracti32x4_epi32(image, 3));
+    }
+    for (size_t j = 0; j < 16; ++j) {
+        slots[j].offset = static_cast<uint8_t>(offsets[j]);
+        slots[j].size = static_cast<uint8_t>(16 - offsets[j]);
+    }
+}
+#endif
+
+using ToDigitsKernel = void (*)(DigitSlot& slot, int value);
+
+// Resolved once, on first use, for the active ISA level
+inline ToDigitsKernel toDigitsKernel() {
+    static const ToDigitsKernel kernel = selectKernel<ToDigitsKernel>({
+#if GML_X86
+        { IsaLevel::Sse2, toDigitsSse2 },
+#endif
+        { IsaLevel::Scalar, toDigitsScalar },
+    });
+    return kernel;
+}
+
+inline void toDigits(DigitSlot& slot, const int value) {
+    toDigitsKernel()(slot, value);
+}
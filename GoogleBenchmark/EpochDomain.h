@@ -0,0 +1,169 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Epoch-based reclamation for read-mostly lock-free structures.
+//
+// Readers pin the current global epoch for the duration of a lookup. Writers
+// unlink an object first and then retire it with the epoch it was retired in.
+// Pins, unlinks and reader loads of shared pointers must all be seq_cst (plain
+// loads on x86) so a reader is either seen as pinned or sees the unlink.
+// The global epoch only advances once every pinned thread has observed it, so
+// an object retired in epoch e is unreachable by any reader once the global
+// epoch reaches e + 2, and is freed then.
+//
+// There is one process-wide domain. Threads claim a participant slot on first
+// use and release it at thread exit, handing any still-unsafe garbage to the
+// domain's orphan list.
+class EpochDomain {
+    struct Participant;
+
+public:
+    static constexpr size_t MAX_THREADS{ 256 };
+
+    using Deleter = void (*)(void*);
+
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // RAII pin for one read-side critical section; pins do not nest
+    class Guard {
+    public:
+        explicit Guard(EpochDomain& domain) : self(domain.participant()) {
+            // seq_cst pairs with the seq_cst slot loads/exchanges of the
+            // structure and the epoch loads in tryAdvance (store-load order)
+            self.epoch.store(domain.globalEpoch.load());
+        }
+        ~Guard() { self.epoch.store(INACTIVE, std::memory_order_release); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        Participant& self;
+    };
+
+    Guard pin() { return Guard(*this); }
+
+    ~EpochDomain() {
+        // Static destruction: no thread can be pinned any more
+        for (auto& p : participants) {
+            for (const auto& r : p.retired) {
+                r.deleter(r.p);
+            }
+        }
+        for (const auto& r : orphans) {
+            r.deleter(r.p);
+        }
+    }
+
+    // Frees p once no pinned reader can still hold it. Call after unlinking.
+    void retire(void* p, const Deleter deleter) {
+        auto& self = participant();
+        self.retired.push_back({ p, deleter, globalEpoch.load() });
+        if (self.retired.size() >= RECLAIM_BATCH) {
+            tryAdvance();
+            reclaim(self.retired);
+        }
+    }
+
+private:
+    static constexpr uint64_t INACTIVE{ UINT64_MAX };
+    static constexpr size_t RECLAIM_BATCH{ 64 };
+
+    struct Retired {
+        void* p;
+        Deleter deleter;
+        uint64_t epoch;
+    };
+
+    struct alignas(64) Participant {
+        std::atomic<uint64_t> epoch{ INACTIVE };
+        std::atomic<bool> claimed{ false };
+        std::vector<Retired> retired;  // Owned by the claiming thread
+    };
+
+    // Releases the calling thread's slot when the thread exits
+    struct Registration {
+        EpochDomain* domain{ nullptr };
+        Participant* slot{ nullptr };
+        ~Registration() {
+            if (slot) {
+                domain->release(*slot);
+            }
+        }
+    };
+
+    Participant& participant() {
+        thread_local Registration registration;
+        if (!registration.slot) {
+            registration.domain = this;
+            registration.slot = &claim();
+        }
+        return *registration.slot;
+    }
+
+    Participant& claim() {
+        for (;;) {
+            for (auto& p : participants) {
+                bool expected = false;
+                if (!p.claimed.load(std::memory_order_relaxed) &&
+                    p.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                    return p;
+                }
+            }
+            // More live threads than slots: wait for one to exit
+            std::this_thread::yield();
+        }
+    }
+
+    void release(Participant& p) {
+        p.epoch.store(INACTIVE, std::memory_order_release);
+        tryAdvance();
+        reclaim(p.retired);
+        if (!p.retired.empty()) {
+            std::lock_guard lock(orphanMutex);
+            orphans.insert(orphans.end(), p.retired.begin(), p.retired.end());
+        }
+        p.retired.clear();
+        p.claimed.store(false, std::memory_order_release);
+    }
+
+    // Advances the global epoch if every pinned thread has observed it
+    void tryAdvance() {
+        uint64_t current = globalEpoch.load();
+        for (const auto& p : participants) {
+            const uint64_t local = p.epoch.load();
+            if (local != INACTIVE && local != current) {
+                return;
+            }
+        }
+        globalEpoch.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel);
+        if (std::unique_lock lock(orphanMutex, std::try_to_lock); lock && !orphans.empty()) {
+            reclaim(orphans);
+        }
+    }
+
+    void reclaim(std::vector<Retired>& retired) const {
+        const uint64_t safe = globalEpoch.load(std::memory_order_acquire);
+        size_t kept = 0;
+        for (const auto& r : retired) {
+            if (r.epoch + 2 <= safe) {
+                r.deleter(r.p);
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+    }
+
+    std::atomic<uint64_t> globalEpoch{ 0 };
+    std::array<Participant, MAX_THREADS> participants;
+    std::mutex orphanMutex;
+    std::vector<Retired> orphans;
+};
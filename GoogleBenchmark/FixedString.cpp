@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include "FixedString.h"
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include <random>
+#include <vector>
+
+static constexpr size_t FIXED_NAMES{ 1'024 };
+static constexpr size_t FIXED_DST{ 1'024 };
+
+// Sample_t records whose names are exactly state.range(0) bytes long
+class FixedStringFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    std::vector<char> out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        const auto length = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        samples.assign(FIXED_NAMES, Sample_t{});
+        for (auto& s : samples) {
+            for (size_t i = 0; i < length; ++i) {
+                s.name[i] = static_cast<char>(letter(rng));
+            }
+        }
+        out.assign(FIXED_DST, '\0');
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+        out.clear();
+    }
+};
+
+static void nameLengthArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("len")->Arg(1)->Arg(8)->Arg(32)->Arg(64)->Arg(128)->Arg(255);
+}
+
+// Length scans
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_strlen)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        size_t size = strlen(samples[idx++ % samples.size()].name);
+        benchmark::DoNotOptimize(size);
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_strlen)->Apply(nameLengthArgs);
+
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_strlen_bounded_memchr)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = samples[idx++ % samples.size()].name;
+        size_t size = boundedStrlenScalar(name, sizeof(name));
+        benchmark::DoNotOptimize(size);
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_strlen_bounded_memchr)->Apply(nameLengthArgs);
+
+#if GML_X86
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_strlen_bounded_sse2)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = samples[idx++ % samples.size()].name;
+        size_t size = boundedStrlenSse2(name, sizeof(name));
+        benchmark::DoNotOptimize(size);
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_strlen_bounded_sse2)->Apply(nameLengthArgs);
+
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_strlen_bounded_avx2)(benchmark::State& state) {
+    if (!cpuHasAvx2()) {
+        state.SkipWithError("AVX2 not supported on this CPU");
+        return;
+    }
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = samples[idx++ % samples.size()].name;
+        size_t size = boundedStrlenAvx2(name, sizeof(name));
+        benchmark::DoNotOptimize(size);
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_strlen_bounded_avx2)->Apply(nameLengthArgs);
+#endif
+
+// Whole name fields, current paths first
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_name_strcat_s)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        out[0] = '\0';
+        strcat_s(out.data(), FIXED_DST, ";$Platform Name:$ ");
+        strcat_s(out.data(), FIXED_DST, s.name);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_name_strcat_s)->Apply(nameLengthArgs);
+
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_name_sprintf_s)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        sprintf_s(out.data(), FIXED_DST, ";$Platform Name:$ %s", s.name);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_name_sprintf_s)->Apply(nameLengthArgs);
+
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_name_fmt_format_to)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        char* pEnd = fmt::format_to(out.data(), ";$Platform Name:$ {}", s.name);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_name_fmt_format_to)->Apply(nameLengthArgs);
+
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_name_fmt_format_to_bounded)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        char* pEnd = fmt::format_to(out.data(), ";$Platform Name:$ {}", fixedChars(s.name));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_name_fmt_format_to_bounded)->Apply(nameLengthArgs);
+
+BENCHMARK_DEFINE_F(FixedStringFixture, GML_name_bounded)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        char* pEnd = writeNameBounded(out.data(), s.name);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(FixedStringFixture, GML_name_bounded)->Apply(nameLengthArgs);
@@ -0,0 +1,88 @@
+#pragma once
+#include "Simd.h"
+#include "fmt/format.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+// Fixed-capacity char arrays such as Sample_t::name are not guaranteed to be
+// null-terminated, so their length is found with a bounded scan that never
+// reads past the array. Capacity-sized arrays are scanned in whole 16/32-byte
+// blocks; a partial block at the end falls back to a scalar scan.
+
+inline size_t boundedStrlenScalar(const char* s, const size_t capacity) {
+    const void* nul = std::memchr(s, '\0', capacity);
+    return nul ? static_cast<size_t>(static_cast<const char*>(nul) - s) : capacity;
+}
+
+#if GML_X86
+inline size_t boundedStrlenSse2(const char* s, const size_t capacity) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t pos = 0;
+    for (; pos + 16 <= capacity; pos += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + pos));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+    return pos + boundedStrlenScalar(s + pos, capacity - pos);
+}
+
+GML_TARGET("avx2")
+inline size_t boundedStrlenAvx2(const char* s, const size_t capacity) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t pos = 0;
+    for (; pos + 32 <= capacity; pos += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + pos));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+    return pos + boundedStrlenSse2(s + pos, capacity - pos);
+}
+#endif
+
+using BoundedStrlenKernel = size_t (*)(const char* s, size_t capacity);
+
+// Resolved once, on first use, for the active ISA level
+inline BoundedStrlenKernel boundedStrlenKernel() {
+    static const BoundedStrlenKernel kernel = selectKernel<BoundedStrlenKernel>({
+#if GML_X86
+        { IsaLevel::Avx2, boundedStrlenAvx2 },
+        { IsaLevel::Sse2, boundedStrlenSse2 },
+#endif
+        { IsaLevel::Scalar, boundedStrlenScalar },
+    });
+    return kernel;
+}
+
+inline size_t boundedStrlen(const char* s, const size_t capacity) {
+    return boundedStrlenKernel()(s, capacity);
+}
+
+template <size_t N>
+inline size_t boundedStrlen(const char (&s)[N]) {
+    return boundedStrlen(s, N);
+}
+
+// Formats a fixed char array without running past its capacity:
+// fmt::format_to(out, "{:<32}", fixedChars(sample.name)). Supports the usual
+// string format specs.
+template <size_t N>
+struct FixedChars {
+    const char* data;
+};
+
+template <size_t N>
+constexpr FixedChars<N> fixedChars(const char (&s)[N]) {
+    return { s };
+}
+
+template <size_t N>
+struct fmt::formatter<FixedChars<N>> : fmt::formatter<fmt::string_view> {
+    auto format(const FixedChars<N>& s, fmt::format_context& ctx) const {
+        return fmt::formatter<fmt::string_view>::format({ s.data, boundedStrlen(s.data, N) }, ctx);
+    }
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include "fmt/format.h"
+
+// Per-iteration fmt stage breakdown for a benchmark run, from the cycle
+// counters of an instrumented fmt (the Instrumented|x64 configuration, which
+// adds FMT_INSTRUMENT=1 to the header-only build). Declare one before the
+// timing loop of each benchmark that formats through fmt's runtime path
+// (format_to, vformat_to, sprintf); when it goes out of scope it reports
+// fmt_parse, fmt_dispatch and fmt_write as cycles per iteration on the
+// calling thread:
+//   fmt_parse     scanning the format string and parsing specs
+//   fmt_dispatch  argument lookup and the type switch, plus custom formatters
+//   fmt_write     literal text and the write_* routines for each argument
+// The probes cost cycles of their own, so the stages add up to more than
+// the uninstrumented time. FMT_COMPILE chains and other writers that bypass
+// the format handler have no probes, so those benchmarks do not declare one.
+// Without FMT_INSTRUMENT this does nothing.
+class FmtStageCounters {
+public:
+#if FMT_INSTRUMENT
+    explicit FmtStageCounters(benchmark::State& state) : state(state), start(fmt::detail::thread_stage_counters()) {}
+
+    ~FmtStageCounters() {
+        static constexpr const char* NAMES[fmt::detail::num_stages] = { "fmt_parse", "fmt_dispatch", "fmt_write" };
+        const auto& now = fmt::detail::thread_stage_counters();
+        for (int i = 0; i < fmt::detail::num_stages; ++i) {
+            state.counters[NAMES[i]] = benchmark::Counter(
+                static_cast<double>(now.cycles[i] - start.cycles[i]), benchmark::Counter::kAvgIterations);
+        }
+    }
+#else
+    explicit FmtStageCounters(benchmark::State& /*state*/) {}
+#endif
+    FmtStageCounters(const FmtStageCounters&) = delete;
+    FmtStageCounters& operator=(const FmtStageCounters&) = delete;
+
+#if FMT_INSTRUMENT
+private:
+    benchmark::State& state;
+    const fmt::detail::stage_counters start;
+#endif
+};
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "fmt/format.h"
+#include <string>
+
+// fmt::vformat (format into a memory_buffer, then copy into a new string)
+// against fmt::format and fmt::format_append, which write straight into the
+// string's storage. Output is "Value: " plus a state.range(0) - 7 character
+// argument, so the whole result is state.range(0) bytes.
+static void outputBytesArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("bytes")->RangeMultiplier(8)->Range(8, 64 << 10);
+}
+
+static std::string makeArgument(const benchmark::State& state) {
+    return std::string(static_cast<size_t>(state.range(0)) - 7, 'x');
+}
+
+static void BM_String_vformat(benchmark::State& state) {
+    const auto text = makeArgument(state);
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string result = fmt::vformat("Value: {}", fmt::make_format_args(text));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_String_vformat)->Apply(outputBytesArgs);
+
+static void BM_String_format(benchmark::State& state) {
+    const auto text = makeArgument(state);
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string result = fmt::format("Value: {}", text);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_String_format)->Apply(outputBytesArgs);
+
+// Into one string reused across iterations: after the first pass its
+// capacity is enough and nothing allocates
+static void BM_String_format_append(benchmark::State& state) {
+    const auto text = makeArgument(state);
+    std::string result;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        result.clear();
+        fmt::format_append(result, "Value: {}", text);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_String_format_append)->Apply(outputBytesArgs);
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+// Pre-rendered "label + value" fragments for a field with a small value
+// domain, e.g. ";$Flag Value:$ Yes". The table is built once (at compile
+// time when declared constexpr) and write() emits a whole fragment with a
+// single fixed-size memcpy of SlotSize bytes, then advances by the fragment's
+// real length. The bytes past the fragment are scratch, so dst needs SlotSize
+// bytes of headroom.
+template <size_t SlotSize, size_t Count>
+class FragmentTable {
+public:
+    template <typename Str>
+    constexpr FragmentTable(const std::string_view label, const std::array<Str, Count>& values) {
+        for (size_t i = 0; i < Count; ++i) {
+            const std::string_view value{ values[i] };
+            if (label.size() + value.size() > SlotSize) {
+                throw std::length_error("fragment does not fit in its slot");
+            }
+            auto& slot = slots[i];
+            size_t n = 0;
+            for (const char c : label) slot.data[n++] = c;
+            for (const char c : value) slot.data[n++] = c;
+            slot.size = n;
+        }
+    }
+
+    char* write(char* dst, const size_t index) const {
+        const auto& slot = slots[index];
+        std::memcpy(dst, slot.data.data(), SlotSize);
+        return dst + slot.size;
+    }
+
+    constexpr std::string_view operator[](const size_t index) const {
+        return { slots[index].data.data(), slots[index].size };
+    }
+
+    static constexpr size_t size() { return Count; }
+
+    // Length of the longest fragment
+    constexpr size_t maxSize() const {
+        size_t longest = 0;
+        for (const auto& slot : slots) {
+            longest = slot.size > longest ? slot.size : longest;
+        }
+        return longest;
+    }
+
+private:
+    struct Slot {
+        std::array<char, SlotSize> data{};
+        size_t size{ 0 };
+    };
+    std::array<Slot, Count> slots{};
+};
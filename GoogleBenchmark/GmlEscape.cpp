@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "GmlEscape.h"
+#include "GmlSerializer.h"
+#include <random>
+#include <vector>
+
+static constexpr size_t ESCAPE_NAMES{ 1'024 };
+
+// Names of state.range(0) bytes in Sample_t-sized arrays, with
+// state.range(1) percent of the bytes replaced by ';', '$' or '\'
+class GmlEscapeFixture : public benchmark::Fixture {
+public:
+    struct Name {
+        char text[sizeof(Sample_t::name)];
+        size_t size;
+    };
+    std::vector<Name> names;
+    std::vector<char> out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        static constexpr char SPECIALS[] = { ';', '$', '\\' };
+        const auto length = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::bernoulli_distribution special(static_cast<double>(state.range(1)) / 100.0);
+        std::uniform_int_distribution<size_t> which(0, std::size(SPECIALS) - 1);
+
+        names.assign(ESCAPE_NAMES, Name{});
+        for (auto& name : names) {
+            for (size_t i = 0; i < length; ++i) {
+                name.text[i] = special(rng) ? SPECIALS[which(rng)] : static_cast<char>(letter(rng));
+            }
+            name.text[length] = '\0';
+            name.size = length;
+        }
+        out.assign(2 * sizeof(Sample_t::name) + 64, '\0');
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        names.clear();
+        out.clear();
+    }
+};
+
+static void escapeArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "len", "special%" })->ArgsProduct({ { 1, 8, 16, 32, 64, 128, 255 }, { 0, 1, 10 } });
+}
+
+// Current behavior: the name is copied verbatim, unescaped
+BENCHMARK_DEFINE_F(GmlEscapeFixture, GML_name_verbatim)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = names[idx++ % names.size()];
+        std::memcpy(out.data(), name.text, name.size);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlEscapeFixture, GML_name_verbatim)->Apply(escapeArgs);
+
+BENCHMARK_DEFINE_F(GmlEscapeFixture, GML_escape_scalar)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = names[idx++ % names.size()];
+        char* pEnd = writeGmlEscapedScalar(out.data(), name.text, name.size);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlEscapeFixture, GML_escape_scalar)->Apply(escapeArgs);
+
+#if GML_X86
+BENCHMARK_DEFINE_F(GmlEscapeFixture, GML_escape_sse2)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = names[idx++ % names.size()];
+        char* pEnd = writeGmlEscapedSse2(out.data(), name.text, name.size, sizeof(name.text));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlEscapeFixture, GML_escape_sse2)->Apply(escapeArgs);
+
+BENCHMARK_DEFINE_F(GmlEscapeFixture, GML_escape_avx2)(benchmark::State& state) {
+    if (!cpuHasAvx2()) {
+        state.SkipWithError("AVX2 not supported on this CPU");
+        return;
+    }
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& name = names[idx++ % names.size()];
+        char* pEnd = writeGmlEscapedAvx2(out.data(), name.text, name.size, sizeof(name.text));
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlEscapeFixture, GML_escape_avx2)->Apply(escapeArgs);
+#endif
+
+// Escaping through fmt::format_to, as the format_to GML variants would use it
+BENCHMARK_DEFINE_F(GmlEscapeFixture, GML_escape_fmt_format_to)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& name = names[idx++ % names.size()];
+        char* pEnd = fmt::format_to(out.data(), "{}", GmlEscaped{ { name.text, name.size } });
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlEscapeFixture, GML_escape_fmt_format_to)->Apply(escapeArgs);
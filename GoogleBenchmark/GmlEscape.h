@@ -0,0 +1,166 @@
+#pragma once
+#include "Simd.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+// GML framing is built from ';' and '$', so free-text fields escape those
+// (and the escape character itself) with a backslash: "a;b" -> "a\;b".
+//
+// The kernels below are modeled on fmt's find_escape/write_escaped_string:
+// find the next byte that needs escaping, copy the clean run before it, write
+// the escape, repeat. The SIMD versions test a whole 16/32-byte block at once
+// and store it unconditionally, so clean blocks cost one load, three compares
+// and one store, and only blocks holding a special byte take a branch.
+//
+// src may be read up to src + capacity (capacity >= size), which lets callers
+// scan a fixed char array in whole blocks. The SIMD kernels may also write up
+// to one block past the escaped output, so dst needs 32 bytes of headroom.
+
+constexpr bool gmlNeedsEscape(const char c) {
+    return c == ';' || c == '$' || c == '\\';
+}
+
+// Returns the first byte that needs escaping, or end
+inline const char* findGmlEscape(const char* begin, const char* end) {
+    for (; begin != end; ++begin) {
+        if (gmlNeedsEscape(*begin)) {
+            return begin;
+        }
+    }
+    return end;
+}
+
+inline char* writeGmlEscapedScalar(char* dst, const char* src, const size_t size) {
+    const char* end = src + size;
+    for (;;) {
+        const char* escape = findGmlEscape(src, end);
+        std::memcpy(dst, src, static_cast<size_t>(escape - src));
+        dst += escape - src;
+        if (escape == end) {
+            return dst;
+        }
+        *dst++ = '\\';
+        *dst++ = *escape;
+        src = escape + 1;
+    }
+}
+
+#if GML_X86
+inline char* writeGmlEscapedSse2(char* dst, const char* src, const size_t size, const size_t capacity) {
+    const __m128i semicolon = _mm_set1_epi8(';');
+    const __m128i dollar = _mm_set1_epi8('$');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const char* end = src + size;
+    const char* limit = src + capacity;
+    while (src < end && limit - src >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+        const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, semicolon), _mm_cmpeq_epi8(v, dollar)),
+            _mm_cmpeq_epi8(v, backslash));
+        const size_t remaining = static_cast<size_t>(end - src);
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (remaining < 16) {
+            mask &= (1u << remaining) - 1;
+        }
+        if (mask == 0) {
+            const size_t n = std::min<size_t>(16, remaining);
+            src += n;
+            dst += n;
+            continue;
+        }
+        // The clean prefix is already in place; escape the special byte and
+        // rescan from just after it.
+        const int n = std::countr_zero(mask);
+        src += n;
+        dst += n;
+        *dst++ = '\\';
+        *dst++ = *src++;
+    }
+    return writeGmlEscapedScalar(dst, src, static_cast<size_t>(end - src));
+}
+
+GML_TARGET("avx2")
+inline char* writeGmlEscapedAvx2(char* dst, const char* src, const size_t size, const size_t capacity) {
+    const __m256i semicolon = _mm256_set1_epi8(';');
+    const __m256i dollar = _mm256_set1_epi8('$');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const char* end = src + size;
+    const char* limit = src + capacity;
+    while (src < end && limit - src >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+        const __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, semicolon), _mm256_cmpeq_epi8(v, dollar)),
+            _mm256_cmpeq_epi8(v, backslash));
+        const size_t remaining = static_cast<size_t>(end - src);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (remaining < 32) {
+            mask &= (1u << remaining) - 1;
+        }
+        if (mask == 0) {
+            const size_t n = std::min<size_t>(32, remaining);
+            src += n;
+            dst += n;
+            continue;
+        }
+        const int n = std::countr_zero(mask);
+        src += n;
+        dst += n;
+        *dst++ = '\\';
+        *dst++ = *src++;
+    }
+    // Fewer than 32 readable bytes left; finish with 16-byte blocks
+    return writeGmlEscapedSse2(dst, src, static_cast<size_t>(end - src), static_cast<size_t>(limit - src));
+}
+#endif
+
+using GmlEscapeKernel = char* (*)(char* dst, const char* src, size_t size, size_t capacity);
+
+inline char* writeGmlEscapedScalarKernel(char* dst, const char* src, const size_t size, const size_t /*capacity*/) {
+    return writeGmlEscapedScalar(dst, src, size);
+}
+
+// Resolved once, on first use, for the active ISA level
+inline GmlEscapeKernel gmlEscapeKernel() {
+    static const GmlEscapeKernel kernel = selectKernel<GmlEscapeKernel>({
+#if GML_X86
+        { IsaLevel::Avx2, writeGmlEscapedAvx2 },
+        { IsaLevel::Sse2, writeGmlEscapedSse2 },
+#endif
+        { IsaLevel::Scalar, writeGmlEscapedScalarKernel },
+    });
+    return kernel;
+}
+
+inline char* writeGmlEscaped(char* dst, const char* src, const size_t size, const size_t capacity) {
+    return gmlEscapeKernel()(dst, src, size, capacity);
+}
+
+inline char* writeGmlEscaped(char* dst, const char* src, const size_t size) {
+    return writeGmlEscaped(dst, src, size, size);
+}
+
+// Formats a string with GML escaping: fmt::format_to(out, "{}", GmlEscaped{ name })
+struct GmlEscaped {
+    fmt::string_view text;
+};
+
+template <>
+struct fmt::formatter<GmlEscaped> {
+    constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+
+    auto format(const GmlEscaped& s, fmt::format_context& ctx) const {
+        static constexpr size_t CHUNK{ 128 };
+        char buf[2 * CHUNK + 32];
+        auto out = ctx.out();
+        for (size_t pos = 0; pos < s.text.size(); pos += CHUNK) {
+            const size_t n = std::min(CHUNK, s.text.size() - pos);
+            const char* end = writeGmlEscaped(buf, s.text.data() + pos, n);
+            out = fmt::detail::copy<char>(static_cast<const char*>(buf), end, out);
+        }
+        return out;
+    }
+};
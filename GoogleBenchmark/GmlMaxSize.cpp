@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "SampleData.h"
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Checked per-field writing: the writers of writeSampleFragments, each
+// preceded by a test that the field's worst case (plus the headroom of its
+// block stores) still fits before dstEnd. The record is abandoned when it
+// does not. GML_record_unchecked differs only in dropping those tests.
+static char* writeSampleChecked(char* dst, char* dstEnd, const Sample_t& sample) {
+    if (static_cast<size_t>(dstEnd - dst) < MAX_FLAG_SIZE + GML_HEADROOM) return nullptr;
+    dst = writeFlagFragment(dst, sample.flag);
+    if (static_cast<size_t>(dstEnd - dst) < MAX_ID_SIZE) return nullptr;
+    dst = writeId(dst, sample.id);
+    if (static_cast<size_t>(dstEnd - dst) < MAX_VALUE_SIZE) return nullptr;
+    dst = writeValue(dst, sample.value);
+    if (static_cast<size_t>(dstEnd - dst) < MAX_NAME_SIZE) return nullptr;
+    return writeNameBounded(dst, sample.name);
+}
+
+class GmlMaxSizeFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+
+    void SetUp(const ::benchmark::State& state) override {
+        samples = makeSamples(static_cast<size_t>(state.range(0)));
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+    }
+};
+
+// One record at a time into a stack buffer of the same size in both
+BENCHMARK_DEFINE_F(GmlMaxSizeFixture, GML_record_checked)(benchmark::State& state) {
+    char record[MAX_SAMPLE_SIZE + GML_HEADROOM];
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = writeSampleChecked(record, record + sizeof(record), samples[idx++ % samples.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(GmlMaxSizeFixture, GML_record_checked)->ArgName("records")->Arg(1'000);
+
+BENCHMARK_DEFINE_F(GmlMaxSizeFixture, GML_record_unchecked)(benchmark::State& state) {
+    // Sized for the worst case, so no checks are needed
+    char record[MAX_SAMPLE_SIZE + GML_HEADROOM];
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = writeSampleFragments(record, samples[idx++ % samples.size()]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(GmlMaxSizeFixture, GML_record_unchecked)->ArgName("records")->Arg(1'000);
+
+// Whole batches into a std::string
+BENCHMARK_DEFINE_F(GmlMaxSizeFixture, GML_batch_back_inserter)(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string out;
+        auto it = std::back_inserter(out);
+        for (const auto& s : samples) {
+            const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+            it = fmt::format_to(it, ";$Flag Value:$ {:s}", yesOrNo);
+            it = fmt::format_to(it, ";$Launcher ID:$ {}", s.id);
+            it = fmt::format_to(it, ";$Predicted Intercept Range:$ {:.3f} dm", s.value);
+            it = fmt::format_to(it, ";$Platform Name:$ {}", fixedChars(s.name));
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlMaxSizeFixture, GML_batch_back_inserter)
+    ->ArgName("records")->Arg(1'000)->Arg(10'000)->Arg(100'000);
+
+BENCHMARK_DEFINE_F(GmlMaxSizeFixture, GML_batch_append_checked)(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string out;
+        char record[1'024];
+        for (const auto& s : samples) {
+            if (char* pEnd = writeSampleChecked(record, record + sizeof(record), s)) {
+                out.append(record, pEnd);
+            }
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlMaxSizeFixture, GML_batch_append_checked)
+    ->ArgName("records")->Arg(1'000)->Arg(10'000)->Arg(100'000);
+
+BENCHMARK_DEFINE_F(GmlMaxSizeFixture, GML_batch_reserve_once)(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string out;
+        appendSamples(out, samples);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(GmlMaxSizeFixture, GML_batch_reserve_once)
+    ->ArgName("records")->Arg(1'000)->Arg(10'000)->Arg(100'000);
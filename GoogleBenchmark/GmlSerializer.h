@@ -0,0 +1,172 @@
+#pragma once
+#include "fmt/format.h"
+#include "FixedString.h"
+#include "FragmentTable.h"
+#include "GmlEscape.h"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+struct Sample_t {
+    uint8_t flag;
+    char pad[3];
+    int id;
+    double value;
+    char name[256];
+};
+
+// GML field labels, in record order
+static constexpr std::string_view FLAG_LABEL{ ";$Flag Value:$ " };
+static constexpr std::string_view ID_LABEL{ ";$Launcher ID:$ " };
+static constexpr std::string_view VALUE_LABEL{ ";$Predicted Intercept Range:$ " };
+static constexpr std::string_view VALUE_UNITS{ " dm" };
+static constexpr std::string_view NAME_LABEL{ ";$Platform Name:$ " };
+
+// Per-field writers. Each one writes a complete field fragment at dst and
+// returns the new end; the output matches GML_fmt_format_to byte for byte.
+inline char* writeFlag(char* dst, const uint8_t flag) {
+    const auto yesOrNo = (flag == 0) ? "No" : "Yes";
+    return fmt::format_to(dst, ";$Flag Value:$ {:s}", yesOrNo);
+}
+
+inline char* writeId(char* dst, const int id) {
+    return fmt::format_to(dst, ";$Launcher ID:$ {}", id);
+}
+
+inline char* writeValue(char* dst, const double value) {
+    return fmt::format_to(dst, ";$Predicted Intercept Range:$ {:.3f} dm", value);
+}
+
+inline char* writeName(char* dst, const char* name) {
+    return fmt::format_to(dst, ";$Platform Name:$ {}", name);
+}
+
+// Bounded name writer: never reads past the name array, even when it is not
+// null-terminated, and copies the name in one shot.
+inline char* writeNameBounded(char* dst, const char (&name)[sizeof(Sample_t::name)]) {
+    std::memcpy(dst, NAME_LABEL.data(), NAME_LABEL.size());
+    dst += NAME_LABEL.size();
+    const size_t size = boundedStrlen(name);
+    std::memcpy(dst, name, size);
+    return dst + size;
+}
+
+// Escaping name writer: ';', '$' and '\\' in the name are backslash-escaped so
+// they cannot break the GML framing. Needs 32 bytes of headroom at dst.
+inline char* writeNameEscaped(char* dst, const char (&name)[sizeof(Sample_t::name)]) {
+    std::memcpy(dst, NAME_LABEL.data(), NAME_LABEL.size());
+    dst += NAME_LABEL.size();
+    return writeGmlEscaped(dst, name, boundedStrlen(name), sizeof(name));
+}
+
+// Flag fragments indexed by (flag != 0)
+static constexpr FragmentTable<32, 2> FLAG_FRAGMENTS{ FLAG_LABEL, std::array{ "No", "Yes" } };
+
+// Fragment-table flag writer; needs 32 bytes of headroom at dst
+inline char* writeFlagFragment(char* dst, const uint8_t flag) {
+    return FLAG_FRAGMENTS.write(dst, flag != 0);
+}
+
+// Writes a whole record; does not null-terminate.
+inline char* writeSample(char* dst, const Sample_t& sample) {
+    dst = writeFlag(dst, sample.flag);
+    dst = writeId(dst, sample.id);
+    dst = writeValue(dst, sample.value);
+    return writeName(dst, sample.name);
+}
+
+// Same output as writeSample, with the flag emitted from FLAG_FRAGMENTS and
+// the name length found with a bounded scan.
+inline char* writeSampleFragments(char* dst, const Sample_t& sample) {
+    dst = writeFlagFragment(dst, sample.flag);
+    dst = writeId(dst, sample.id);
+    dst = writeValue(dst, sample.value);
+    return writeNameBounded(dst, sample.name);
+}
+
+// Compile-time upper bounds on the encoded size of each field and of a whole
+// record, derived from the field types and label lengths. A buffer of
+// MAX_SAMPLE_SIZE + GML_HEADROOM bytes holds any record written by the
+// writers above, so they run with no bounds checks; GML_HEADROOM covers the
+// fixed-size block stores of the fragment, digit and SIMD copy paths.
+template <typename Int>
+constexpr size_t maxDecimalChars() {
+    return std::numeric_limits<Int>::digits10 + 1 + (std::is_signed_v<Int> ? 1 : 0);
+}
+
+// "{:.Nf}" of a double: sign, every integer digit of DBL_MAX, point, fraction
+template <size_t Precision>
+constexpr size_t maxFixedChars() {
+    return 1 + (std::numeric_limits<double>::max_exponent10 + 1) + 1 + Precision;
+}
+
+static constexpr size_t VALUE_PRECISION{ 3 };
+static constexpr size_t MAX_FLAG_SIZE{ FLAG_FRAGMENTS.maxSize() };
+static constexpr size_t MAX_ID_SIZE{ ID_LABEL.size() + maxDecimalChars<decltype(Sample_t::id)>() };
+static constexpr size_t MAX_VALUE_SIZE{ VALUE_LABEL.size() + maxFixedChars<VALUE_PRECISION>() + VALUE_UNITS.size() };
+static constexpr size_t MAX_NAME_SIZE{ NAME_LABEL.size() + sizeof(Sample_t::name) };
+static constexpr size_t MAX_NAME_ESCAPED_SIZE{ NAME_LABEL.size() + 2 * sizeof(Sample_t::name) };
+static constexpr size_t MAX_SAMPLE_SIZE{ MAX_FLAG_SIZE + MAX_ID_SIZE + MAX_VALUE_SIZE + MAX_NAME_SIZE };
+static constexpr size_t GML_HEADROOM{ 32 };
+
+static_assert(MAX_FLAG_SIZE == FLAG_LABEL.size() + 3, "\"Yes\" is the longest flag value");
+static_assert(MAX_ID_SIZE == ID_LABEL.size() + 11, "\"-2147483648\" is the longest int");
+
+// <charconv> writers: memcpy of the literals plus std::to_chars, with no
+// format string, locale or allocation. Same output as writeSample; the
+// to_chars bounds are the per-field maxima above, so dst needs
+// MAX_SAMPLE_SIZE bytes.
+inline char* writeFlagToChars(char* dst, const uint8_t flag) {
+    const std::string_view yesOrNo = (flag == 0) ? "No" : "Yes";
+    std::memcpy(dst, FLAG_LABEL.data(), FLAG_LABEL.size());
+    dst += FLAG_LABEL.size();
+    std::memcpy(dst, yesOrNo.data(), yesOrNo.size());
+    return dst + yesOrNo.size();
+}
+
+inline char* writeIdToChars(char* dst, const int id) {
+    std::memcpy(dst, ID_LABEL.data(), ID_LABEL.size());
+    dst += ID_LABEL.size();
+    return std::to_chars(dst, dst + maxDecimalChars<int>(), id).ptr;
+}
+
+inline char* writeValueToChars(char* dst, const double value) {
+    std::memcpy(dst, VALUE_LABEL.data(), VALUE_LABEL.size());
+    dst += VALUE_LABEL.size();
+    dst = std::to_chars(dst, dst + maxFixedChars<VALUE_PRECISION>(), value, std::chars_format::fixed,
+        static_cast<int>(VALUE_PRECISION)).ptr;
+    std::memcpy(dst, VALUE_UNITS.data(), VALUE_UNITS.size());
+    return dst + VALUE_UNITS.size();
+}
+
+inline char* writeSampleToChars(char* dst, const Sample_t& sample) {
+    dst = writeFlagToChars(dst, sample.flag);
+    dst = writeIdToChars(dst, sample.id);
+    dst = writeValueToChars(dst, sample.value);
+    return writeNameBounded(dst, sample.name);
+}
+
+// Appends a batch of records to out, reserving the worst case once up front
+// instead of checking capacity per field, then trims to the real size.
+inline void appendSamples(std::string& out, const std::span<const Sample_t> samples) {
+    const size_t oldSize = out.size();
+    const size_t bound = oldSize + samples.size() * MAX_SAMPLE_SIZE + GML_HEADROOM;
+    const auto writeAll = [&](char* data, size_t) {
+        char* pEnd = data + oldSize;
+        for (const auto& s : samples) {
+            pEnd = writeSampleFragments(pEnd, s);
+        }
+        return static_cast<size_t>(pEnd - data);
+    };
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    out.resize_and_overwrite(bound, writeAll);
+#else
+    out.resize(bound);
+    out.resize(writeAll(out.data(), bound));
+#endif
+}
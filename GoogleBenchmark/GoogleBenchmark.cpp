@@ -1,6 +1,14 @@
 #include <benchmark/benchmark.h>
 #include "fmt/core.h"
+#include "GmlSerializer.h"
+#include "DecodeEnum.h"
+#include "FmtStages.h"
+#include "Simd.h"
+#include "TempFormat.h"
+#include <charconv>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <format>  // C++20
 #include <stdio.h>
@@ -87,6 +95,45 @@ static void BM_ReserveAppend(benchmark::State& state) {
 }
 BENCHMARK(BM_ReserveAppend);
 
+// Method 6: <charconv> to buffer then string (locale-free, allocation-free floor)
+static void BM_ToChars(benchmark::State& state) {
+    int id = 12345;
+    double price = 99.99;
+    const char* name = "Widget";
+    char buffer[256];
+
+    for (auto _ : state) {
+        char* p = buffer;
+        const auto append = [&p](const std::string_view text) {
+            std::memcpy(p, text.data(), text.size());
+            p += text.size();
+        };
+        append("Product: ");
+        append(name);
+        append(", ID: ");
+        p = std::to_chars(p, buffer + sizeof(buffer), id).ptr;
+        append(", Price: $");
+        p = std::to_chars(p, buffer + sizeof(buffer), price, std::chars_format::fixed, 2).ptr;
+        std::string result(buffer, p);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ToChars);
+
+// Method 7: fmt into the reused thread-local buffer; no std::string at all
+static void BM_FormatTemp(benchmark::State& state) {
+    int id = 12345;
+    double price = 99.99;
+    const char* name = "Widget";
+
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        std::string_view result = formatTemp("Product: {}, ID: {}, Price: ${:.2f}", name, id, price);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FormatTemp);
+
 // Bonus: Compare with different string lengths
 static void BM_Format_ShortString(benchmark::State& state) {
     int n = 42;
@@ -106,14 +153,6 @@ static void BM_Concat_ShortString(benchmark::State& state) {
 }
 BENCHMARK(BM_Concat_ShortString);
 
-struct Sample_t {
-    uint8_t flag;
-    char pad[3];
-    int id;
-    double value;
-    char name[256];
-};
-
 static constexpr size_t MAX_DST{ 300'000 };
 static char dst_buffer[MAX_DST]{};
 static char tmp_buffer[MAX_DST]{};
@@ -222,6 +261,7 @@ static void GML_std_format_to(benchmark::State& state) {
 BENCHMARK(GML_std_format_to);
 
 static void GML_fmt_format(benchmark::State& state) {
+    const FmtStageCounters stages(state);
     for (auto _ : state) {
         state.PauseTiming();
         // This runs EVERY iteration (once per loop)
@@ -243,7 +283,51 @@ static void GML_fmt_format(benchmark::State& state) {
 
 BENCHMARK(GML_fmt_format);
 
+// GML_fmt_format with each piece formatted into the reused thread-local
+// buffer instead of a std::string
+static void GML_fmt_format_temp(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        // This runs EVERY iteration (once per loop)
+        initBuffers();
+        state.ResumeTiming();
+        const auto yesOrNo = (sample.flag == 0) ? "No" : "Yes";
+        strcat_s(dst_buffer, MAX_DST, formatTemp(";$Flag Value:$ {:s}", yesOrNo).data());
+        strcat_s(dst_buffer, MAX_DST, formatTemp(";$Launcher ID:$ {}", sample.id).data());
+        strcat_s(dst_buffer, MAX_DST, formatTemp(";$Predicted Intercept Range:$ {:.3f} dm", sample.value).data());
+        strcat_s(dst_buffer, MAX_DST, formatTemp(";$Platform Name:$ {}", sample.name).data());
+        benchmark::DoNotOptimize(dst_buffer);
+        benchmark::DoNotOptimize(tmp_buffer);
+    }
+}
+
+BENCHMARK(GML_fmt_format_temp);
+
+// The four pieces built into one pooled buffer, then one strcat_s
+static void GML_fmt_format_builder(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        // This runs EVERY iteration (once per loop)
+        initBuffers();
+        state.ResumeTiming();
+        TempFormatBuilder record;
+        const auto yesOrNo = (sample.flag == 0) ? "No" : "Yes";
+        record.append(";$Flag Value:$ {:s}", yesOrNo)
+            .append(";$Launcher ID:$ {}", sample.id)
+            .append(";$Predicted Intercept Range:$ {:.3f} dm", sample.value)
+            .append(";$Platform Name:$ {}", sample.name);
+        strcat_s(dst_buffer, MAX_DST, record.c_str());
+        benchmark::DoNotOptimize(dst_buffer);
+        benchmark::DoNotOptimize(tmp_buffer);
+    }
+}
+
+BENCHMARK(GML_fmt_format_builder);
+
 static void GML_fmt_format_to(benchmark::State& state) {
+    const FmtStageCounters stages(state);
     for (auto _ : state) {
         state.PauseTiming();
         // This runs EVERY iteration (once per loop)
@@ -263,4 +347,117 @@ static void GML_fmt_format_to(benchmark::State& state) {
 
 BENCHMARK(GML_fmt_format_to);
 
-BENCHMARK_MAIN();
+// memcpy of the literals plus std::to_chars: the charconv floor for fmt
+static void GML_to_chars(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        // This runs EVERY iteration (once per loop)
+        initBuffers();
+        state.ResumeTiming();
+        auto pEnd = dst_buffer + strlen(dst_buffer);
+        pEnd = writeSampleToChars(pEnd, sample);
+        *pEnd = '\0'; // Null-terminate
+        benchmark::DoNotOptimize(dst_buffer);
+        benchmark::DoNotOptimize(tmp_buffer);
+    }
+}
+
+BENCHMARK(GML_to_chars);
+
+// Pre-rendered fragment tables versus the doYesOrNo/doCharArray helpers.
+// The status field stands in for any enum-valued field.
+static int status{ static_cast<int>(StatusCode::Timeout) };
+
+// Status fragments for STATUS_NAMES, with "Unknown" in the last slot
+static constexpr auto STATUS_FRAGMENTS = [] {
+    std::array<std::string_view, STATUS_NAMES.size() + 1> values{};
+    for (size_t i = 0; i < STATUS_NAMES.size(); ++i) {
+        values[i] = STATUS_NAMES[i];
+    }
+    values.back() = "Unknown";
+    return FragmentTable<32, STATUS_NAMES.size() + 1>{ ";$Status:$ ", values };
+}();
+
+static char* writeStatusFragment(char* dst, const int code) {
+    size_t index = STATUS_NAMES.size();
+    if (const int i = code - STATUS_OFFSET; i >= 0 && i < static_cast<int>(STATUS_NAMES.size())) {
+        index = static_cast<size_t>(i);
+    }
+    return STATUS_FRAGMENTS.write(dst, index);
+}
+
+static void GML_doYesOrNo(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        // This runs EVERY iteration (once per loop)
+        initBuffers();
+        state.ResumeTiming();
+        doYesOrNo(dst_buffer, ";$Flag Value:$ ", sample.flag);
+        doCharArray(dst_buffer, ";$Status:$ ", DecodeArray(status));
+        benchmark::DoNotOptimize(dst_buffer);
+        benchmark::DoNotOptimize(tmp_buffer);
+    }
+}
+
+BENCHMARK(GML_doYesOrNo);
+
+static void GML_fragment_table(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        // This runs EVERY iteration (once per loop)
+        initBuffers();
+        state.ResumeTiming();
+        auto pEnd = dst_buffer + strlen(dst_buffer);
+        pEnd = writeFlagFragment(pEnd, sample.flag);
+        pEnd = writeStatusFragment(pEnd, status);
+        *pEnd = '\0'; // Null-terminate
+        benchmark::DoNotOptimize(dst_buffer);
+        benchmark::DoNotOptimize(tmp_buffer);
+    }
+}
+
+BENCHMARK(GML_fragment_table);
+
+static void GML_fmt_format_to_fragments(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        // This runs EVERY iteration (once per loop)
+        initBuffers();
+        state.ResumeTiming();
+        auto pEnd = dst_buffer + strlen(dst_buffer);
+        pEnd = writeSampleFragments(pEnd, sample);
+        *pEnd = '\0'; // Null-terminate
+        benchmark::DoNotOptimize(dst_buffer);
+        benchmark::DoNotOptimize(tmp_buffer);
+    }
+}
+
+BENCHMARK(GML_fmt_format_to_fragments);
+
+// BENCHMARK_MAIN plus --gml_isa=<level>, which caps the kernels the runtime
+// dispatch may pick (scalar, sse2, sse4.1, avx2, avx512, avx512vbmi) so each
+// ISA level can be compared on one machine. Levels above the CPU's are
+// clamped to what it supports.
+int main(int argc, char** argv) {
+    constexpr std::string_view ISA_FLAG = "--gml_isa=";
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (!arg.starts_with(ISA_FLAG)) {
+            argv[kept++] = argv[i];
+        } else if (!parseIsaLevel(arg.substr(ISA_FLAG.size()), isaLevelLimit())) {
+            fprintf(stderr, "unknown ISA level: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    argc = kept;
+    benchmark::AddCustomContext("gml_isa", std::string(isaLevelName(activeIsaLevel())));
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "LocaleInfo.h"
+#include "SampleData.h"
+#include <locale>
+#include <stdexcept>
+#include <vector>
+
+// Launcher IDs written with "{:L}" as in the operator-facing reports.
+// state.range(0) picks the locale: 0 "C" (no grouping), 1 en_US (1,234,567),
+// 2 de_DE (1.234.567). Names are tried in Windows then POSIX spelling; a
+// benchmark whose locale is not installed is skipped.
+class LocaleFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    std::locale locale;
+    bool available{ false };
+    fmt::memory_buffer out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        static const std::vector<std::vector<const char*>> NAMES = {
+            { "C" }, { "en-US", "en_US.UTF-8", "en_US" }, { "de-DE", "de_DE.UTF-8", "de_DE" }
+        };
+        samples = makeSamples(1'024);
+        available = false;
+        for (const char* name : NAMES[static_cast<size_t>(state.range(0))]) {
+            try {
+                locale = std::locale(name);
+                available = true;
+                break;
+            } catch (const std::runtime_error&) {
+            }
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+    }
+};
+
+static void localeArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("locale")->DenseRange(0, 2);
+}
+
+// fmt as shipped: numpunct is consulted for every argument
+BENCHMARK_DEFINE_F(LocaleFixture, GML_locale_fmt)(benchmark::State& state) {
+    if (!available) {
+        state.SkipWithError("locale not installed");
+        return;
+    }
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        out.clear();
+        fmt::format_to(fmt::appender(out), locale, ";$Launcher ID:$ {:L}", s.id);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(LocaleFixture, GML_locale_fmt)->Apply(localeArgs);
+
+// fmt's own remedy: a format_facet imbued into the locale holds the
+// separator and grouping, found per argument through has_facet/use_facet
+BENCHMARK_DEFINE_F(LocaleFixture, GML_locale_fmt_facet)(benchmark::State& state) {
+    if (!available) {
+        state.SkipWithError("locale not installed");
+        return;
+    }
+    const std::locale withFacet(locale, new fmt::format_facet<std::locale>(locale));
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        out.clear();
+        fmt::format_to(fmt::appender(out), withFacet, ";$Launcher ID:$ {:L}", s.id);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(LocaleFixture, GML_locale_fmt_facet)->Apply(localeArgs);
+
+// The locale info looked up in the cache on every call, as a report writer
+// handed a std::locale would
+BENCHMARK_DEFINE_F(LocaleFixture, GML_locale_cached)(benchmark::State& state) {
+    if (!available) {
+        state.SkipWithError("locale not installed");
+        return;
+    }
+    LocaleInfoCache cache;
+    const auto& first = samples.front();
+    fmt::memory_buffer expected;
+    fmt::format_to(fmt::appender(expected), locale, ";$Launcher ID:$ {:L}", first.id);
+    out.clear();
+    vformatLocalized(out, ";$Launcher ID:$ {:L}", fmt::make_format_args(first.id), cache.get(locale));
+    if (fmt::to_string(out) != fmt::to_string(expected)) {
+        state.SkipWithError("cached locale output differs from fmt");
+        return;
+    }
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        out.clear();
+        vformatLocalized(out, ";$Launcher ID:$ {:L}", fmt::make_format_args(s.id), cache.get(locale));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_REGISTER_F(LocaleFixture, GML_locale_cached)->Apply(localeArgs);
@@ -0,0 +1,152 @@
+#pragma once
+#include "fmt/format.h"
+#include <locale>
+#include <memory>
+#include <vector>
+
+// Locale-aware "{:L}" output without consulting std::locale on every call.
+// fmt resolves a localized integer through write_loc, which builds a
+// format_facet from the locale's numpunct (grouping string, separator) per
+// argument, and a localized float asks numpunct again for the grouping and
+// the decimal point. LocaleInfo captures all three once per locale, and
+// vformatLocalized formats like fmt::vformat_to with localized arguments
+// written from it. Output matches fmt's for the same locale.
+struct LocaleInfo {
+    std::locale locale;
+    fmt::detail::digit_grouping<char> grouping;
+    char decimalPoint;
+
+    explicit LocaleInfo(const std::locale& loc)
+        : locale(loc), grouping(fmt::locale_ref(locale)), decimalPoint(fmt::detail::decimal_point<char>(locale)) {}
+};
+
+// One LocaleInfo per distinct locale, compared with std::locale::operator==
+// (by name, or by identity for unnamed locales). A process formats in a
+// handful of locales, so a linear search beats hashing names. Entries are
+// never evicted and keep their address. Not synchronized: one cache per
+// thread, or fill it at startup.
+class LocaleInfoCache {
+public:
+    const LocaleInfo& get(const std::locale& loc) {
+        for (const auto& info : infos) {
+            if (info->locale == loc) {
+                return *info;
+            }
+        }
+        return *infos.emplace_back(std::make_unique<LocaleInfo>(loc));
+    }
+
+    size_t size() const { return infos.size(); }
+
+private:
+    std::vector<std::unique_ptr<LocaleInfo>> infos;
+};
+
+// Writes one localized argument from the cached info. Integers are grouped
+// like fmt's loc_writer does. Floats are written unlocalized and unpadded
+// first, then their integer digits are grouped and the decimal point
+// swapped; hex floats and zero padding, where the digits do not start the
+// output, go through fmt with the locale. Everything else ignores L the
+// way fmt does.
+struct LocalizedArgFormatter {
+    fmt::appender out;
+    const fmt::format_specs& specs;
+    const LocaleInfo& info;
+
+    template <typename T>
+    void operator()(const T value) {
+        FMT_STAGE_PROBE(write);
+        if constexpr (fmt::detail::is_integer<T>::value) {
+            const auto arg = fmt::detail::make_write_int_arg(value, specs.sign());
+            fmt::detail::write_int(out, static_cast<fmt::detail::uint64_or_128_t<T>>(arg.abs_value), arg.prefix,
+                specs, info.grouping);
+        } else if constexpr (fmt::detail::is_floating_point<T>::value) {
+            if (specs.type() == fmt::presentation_type::hexfloat || specs.align() == fmt::align::numeric) {
+                fmt::detail::arg_formatter<char>{ out, specs, info.locale }(value);
+            } else {
+                writeFloat(value);
+            }
+        } else {
+            fmt::detail::arg_formatter<char>{ out, specs, info.locale }(value);
+        }
+    }
+
+private:
+    template <typename T>
+    void writeFloat(const T value) {
+        fmt::format_specs plain;
+        plain.set_type(specs.type());
+        plain.set_sign(specs.sign());
+        plain.precision = specs.precision;
+        if (specs.alt()) {
+            plain.set_alt();
+        }
+        if (specs.upper()) {
+            plain.set_upper();
+        }
+        fmt::memory_buffer digits;
+        fmt::detail::write<char>(fmt::appender(digits), value, plain);
+
+        const char* begin = digits.data();
+        const char* end = begin + digits.size();
+        const char* intBegin = begin + (begin != end && (*begin == '-' || *begin == '+' || *begin == ' '));
+        const char* intEnd = intBegin;
+        while (intEnd != end && *intEnd >= '0' && *intEnd <= '9') {
+            ++intEnd;
+        }
+        const auto intDigits = static_cast<int>(intEnd - intBegin);
+        const size_t size = digits.size() + static_cast<size_t>(info.grouping.count_separators(intDigits));
+        fmt::detail::write_padded<char, fmt::align::right>(out, specs, size, [&](auto it) {
+            it = fmt::detail::copy<char>(begin, intBegin, it);
+            it = info.grouping.apply(it, fmt::string_view(intBegin, static_cast<size_t>(intDigits)));
+            const char* rest = intEnd;
+            if (rest != end && *rest == '.') {
+                *it++ = info.decimalPoint;
+                ++rest;
+            }
+            return fmt::detail::copy<char>(rest, end, it);
+        });
+    }
+};
+
+// fmt's format handler with "L" arguments written from a LocaleInfo
+struct LocalizedFormatHandler : fmt::detail::format_handler<char> {
+    const LocaleInfo& info;
+
+    const char* on_format_specs(const int id, const char* begin, const char* end) {
+        FMT_STAGE_PROBE(dispatch);
+        auto arg = ctx.arg(id);
+        if (!arg) {
+            fmt::report_error("argument not found");
+        }
+        if (arg.format_custom(begin, parse_ctx, ctx)) {
+            return parse_ctx.begin();
+        }
+        auto specs = fmt::detail::dynamic_format_specs<char>();
+        {
+            FMT_STAGE_PROBE(parse);
+            begin = fmt::detail::parse_format_specs(begin, end, specs, parse_ctx, arg.type());
+        }
+        if (specs.dynamic()) {
+            fmt::detail::handle_dynamic_spec(specs.dynamic_width(), specs.width, specs.width_ref, ctx);
+            fmt::detail::handle_dynamic_spec(specs.dynamic_precision(), specs.precision, specs.precision_ref, ctx);
+        }
+        if (specs.localized()) {
+            arg.visit(LocalizedArgFormatter{ ctx.out(), specs, info });
+        } else {
+            arg.visit(fmt::detail::arg_formatter<char>{ ctx.out(), specs, ctx.locale() });
+        }
+        return begin;
+    }
+};
+
+// fmt::vformat_to(appender, locale, format, args) with the locale's
+// numpunct data taken from info. The context carries info's locale, so
+// custom formatters calling ctx.locale() see the same one.
+inline void vformatLocalized(fmt::detail::buffer<char>& buffer, const fmt::string_view format,
+    const fmt::format_args args, const LocaleInfo& info) {
+    FMT_STAGE_PROBE(parse);
+    LocalizedFormatHandler handler{
+        { fmt::parse_context<char>(format), fmt::context(fmt::appender(buffer), args, info.locale) }, info };
+    fmt::detail::parse_format_string(format, handler);
+}
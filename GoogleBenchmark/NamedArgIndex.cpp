@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "NamedArgIndex.h"
+#include "SampleData.h"
+#include "fmt/args.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// A GML record template with n named fields, four per Sample_t, named like
+// "launcher_id_3". The field order fixes the argument ids, so the runtime
+// table and the static index map the same name to the same id.
+static constexpr const char* FIELD_PREFIXES[] = { "flag_value", "launcher_id", "intercept_range", "platform_name" };
+static constexpr size_t FIELD_NAME_SIZE{ 24 };
+
+static constexpr FieldName<FIELD_NAME_SIZE> gmlFieldName(const size_t field) {
+    FieldName<FIELD_NAME_SIZE> name;
+    size_t size = 0;
+    for (const char* p = FIELD_PREFIXES[field % 4]; *p != '\0'; ++p) {
+        name.data[size++] = *p;
+    }
+    name.data[size++] = '_';
+    char digits[8]{};
+    size_t count = 0;
+    size_t record = field / 4;
+    do {
+        digits[count++] = static_cast<char>('0' + record % 10);
+        record /= 10;
+    } while (record != 0);
+    while (count != 0) {
+        name.data[size++] = digits[--count];
+    }
+    return name;
+}
+
+template <size_t... Fields>
+StaticNameIndex<gmlFieldName(Fields)...> gmlStaticIndex(std::index_sequence<Fields...>);
+
+template <size_t FieldCount>
+using GmlStaticIndex = decltype(gmlStaticIndex(std::make_index_sequence<FieldCount>{}));
+
+struct NamedRecord {
+    std::vector<Sample_t> samples;
+    std::vector<std::string> names;
+    std::string format;
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    NamedArgTable table;
+
+    explicit NamedRecord(const size_t fields) : samples(makeSamples(fields / 4)), table(fields) {
+        static constexpr const char* LABELS[] = {
+            ";$Flag Value:$ {{{}:s}}", ";$Launcher ID:$ {{{}}}",
+            ";$Predicted Intercept Range:$ {{{}:.3f}} dm", ";$Platform Name:$ {{{}}}"
+        };
+        for (size_t i = 0; i < fields; ++i) {
+            names.emplace_back(gmlFieldName(i).data);
+            format += fmt::format(fmt::runtime(LABELS[i % 4]), names.back());
+        }
+        for (size_t i = 0; i < fields; ++i) {
+            const auto& s = samples[i / 4];
+            const char* name = names[i].c_str();
+            switch (i % 4) {
+            case 0: store.push_back(fmt::arg(name, (s.flag == 0) ? "No" : "Yes")); break;
+            case 1: store.push_back(fmt::arg(name, s.id)); break;
+            case 2: store.push_back(fmt::arg(name, s.value)); break;
+            default: store.push_back(fmt::arg(name, static_cast<const char*>(s.name))); break;
+            }
+            table.add(names[i], static_cast<int>(i));
+        }
+    }
+};
+
+static void namedFieldArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("fields")->RangeMultiplier(2)->Range(4, 128);
+}
+
+// fmt as shipped: vformat_to, names found by get_id's linear scan
+static void GML_named_fmt_vformat_to(benchmark::State& state) {
+    const NamedRecord record(static_cast<size_t>(state.range(0)));
+    fmt::memory_buffer out;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        out.clear();
+        fmt::vformat_to(fmt::appender(out), record.format, record.store);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(GML_named_fmt_vformat_to)->Apply(namedFieldArgs);
+
+// The same linear scan through vformatIndexed, so only the lookup differs
+// from the indexed variants
+static void GML_named_linear(benchmark::State& state) {
+    const NamedRecord record(static_cast<size_t>(state.range(0)));
+    const LinearNameIndex index{ record.store };
+    fmt::memory_buffer out;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        out.clear();
+        vformatIndexed(out, record.format, record.store, index);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(GML_named_linear)->Apply(namedFieldArgs);
+
+static void GML_named_table(benchmark::State& state) {
+    const NamedRecord record(static_cast<size_t>(state.range(0)));
+    fmt::memory_buffer out;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        out.clear();
+        vformatIndexed(out, record.format, record.store, record.table);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(GML_named_table)->Apply(namedFieldArgs);
+
+template <size_t FieldCount>
+static void GML_named_static(benchmark::State& state) {
+    const NamedRecord record(FieldCount);
+    const GmlStaticIndex<FieldCount> index;
+    fmt::memory_buffer out;
+    fmt::memory_buffer expected;
+    fmt::vformat_to(fmt::appender(expected), record.format, record.store);
+    vformatIndexed(out, record.format, record.store, index);
+    if (fmt::to_string(out) != fmt::to_string(expected)) {
+        state.SkipWithError("static index output differs from vformat_to");
+        return;
+    }
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        out.clear();
+        vformatIndexed(out, record.format, record.store, index);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_TEMPLATE(GML_named_static, 4)->ArgName("fields")->Arg(4);
+BENCHMARK_TEMPLATE(GML_named_static, 8)->ArgName("fields")->Arg(8);
+BENCHMARK_TEMPLATE(GML_named_static, 16)->ArgName("fields")->Arg(16);
+BENCHMARK_TEMPLATE(GML_named_static, 32)->ArgName("fields")->Arg(32);
+BENCHMARK_TEMPLATE(GML_named_static, 64)->ArgName("fields")->Arg(64);
+BENCHMARK_TEMPLATE(GML_named_static, 128)->ArgName("fields")->Arg(128);
+
+#if FMT_USE_NONTYPE_TEMPLATE_ARGS
+using namespace fmt::literals;
+
+// One record through "name"_a arguments: fmt::format_to against the static
+// index built from the same arguments' types
+static void GML_named_udl_format_to(benchmark::State& state) {
+    const auto samples = makeSamples(1'024);
+    fmt::memory_buffer out;
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        out.clear();
+        fmt::format_to(fmt::appender(out),
+            ";$Flag Value:$ {flag:s};$Launcher ID:$ {launcher_id};$Predicted Intercept Range:$ {range:.3f} dm;$Platform Name:$ {platform_name}",
+            "flag"_a = (s.flag == 0) ? "No" : "Yes", "launcher_id"_a = s.id, "range"_a = s.value,
+            "platform_name"_a = static_cast<const char*>(s.name));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(GML_named_udl_format_to);
+
+static void GML_named_udl_static(benchmark::State& state) {
+    const auto samples = makeSamples(1'024);
+    fmt::memory_buffer out;
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        out.clear();
+        formatStaticNamed(out,
+            ";$Flag Value:$ {flag:s};$Launcher ID:$ {launcher_id};$Predicted Intercept Range:$ {range:.3f} dm;$Platform Name:$ {platform_name}",
+            "flag"_a = (s.flag == 0) ? "No" : "Yes", "launcher_id"_a = s.id, "range"_a = s.value,
+            "platform_name"_a = static_cast<const char*>(s.name));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(GML_named_udl_static);
+#endif
@@ -0,0 +1,242 @@
+#pragma once
+#include "fmt/format.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Indexed lookup of named arguments for wide record templates. fmt finds
+// "{launcher_id}" through basic_format_args::get_id, a linear compare over
+// every named argument, so a template with n named fields costs O(n^2)
+// string compares per record. vformatIndexed formats like fmt::vformat_to
+// but resolves names through an index: NamedArgTable for names only known at
+// runtime, StaticNameIndex (a perfect hash built at compile time) for
+// fmt's static "name"_a arguments.
+
+// FNV-1a over the name with a multiply-xorshift finalizer; constexpr so the
+// static index can be built at compile time
+constexpr uint64_t hashName(const std::string_view name) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (const char c : name) {
+        h = (h ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+    }
+    h ^= h >> 32;
+    h *= 0xd6e8feb86659fd93ull;
+    h ^= h >> 32;
+    return h;
+}
+
+// Open-addressing table from name to argument id, built once per record
+// layout. The names are not copied: like fmt's named_arg_info they must
+// outlive the table.
+class NamedArgTable {
+public:
+    NamedArgTable() = default;
+    explicit NamedArgTable(const size_t expected)
+        : slots(std::bit_ceil(std::max<size_t>(expected * 2, 2))), mask(slots.size() - 1) {}
+
+    void add(const std::string_view name, const int id) {
+        if ((count + 1) * 2 > slots.size()) {
+            rehash(std::max<size_t>(slots.size() * 2, 4));
+        }
+        insert({ hashName(name), name, id });
+        ++count;
+    }
+
+    int find(const std::string_view name) const {
+        if (count == 0) {
+            return -1;
+        }
+        const uint64_t hash = hashName(name);
+        for (size_t slot = hash & mask; slots[slot].id >= 0; slot = (slot + 1) & mask) {
+            if (slots[slot].hash == hash && slots[slot].name == name) {
+                return slots[slot].id;
+            }
+        }
+        return -1;
+    }
+
+    size_t size() const { return count; }
+
+private:
+    struct Slot {
+        uint64_t hash{ 0 };
+        std::string_view name;
+        int id{ -1 };
+    };
+
+    void insert(const Slot& entry) {
+        size_t slot = entry.hash & mask;
+        while (slots[slot].id >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = entry;
+    }
+
+    void rehash(const size_t size) {
+        auto old = std::move(slots);
+        slots.assign(size, Slot{});
+        mask = size - 1;
+        for (const auto& entry : old) {
+            if (entry.id >= 0) {
+                insert(entry);
+            }
+        }
+    }
+
+    std::vector<Slot> slots;
+    size_t mask{ 0 };
+    size_t count{ 0 };
+};
+
+// Names known at compile time. Each name is an object with a null-terminated
+// data member (fmt::detail::fixed_string, or FieldName below) and its id is
+// its position in the pack. Hash-and-displace: names are split into buckets
+// by hash, and each bucket gets the first displacement that drops all its
+// names into free slots of a table twice the size of the set. A lookup is
+// one hash, one mix and one compare, with no probing.
+template <auto... Names>
+class StaticNameIndex {
+    static constexpr size_t COUNT{ sizeof...(Names) };
+    static constexpr size_t TABLE_SIZE{ std::bit_ceil(std::max<size_t>(COUNT * 2, 2)) };
+    static constexpr size_t BUCKETS{ std::bit_ceil(std::max<size_t>(COUNT / 2, 1)) };
+
+    static constexpr std::array<std::string_view, COUNT> NAMES{ std::string_view(Names.data)... };
+
+    static constexpr size_t slotOf(const uint64_t hash, const uint32_t displacement) {
+        uint64_t h = hash ^ (displacement * 0x9e3779b97f4a7c15ull);
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 32;
+        return h & (TABLE_SIZE - 1);
+    }
+
+    struct Table {
+        std::array<uint32_t, BUCKETS> displacements{};
+        std::array<int, TABLE_SIZE> ids{};
+    };
+
+    static constexpr Table build() {
+        Table table;
+        for (auto& id : table.ids) {
+            id = -1;
+        }
+        std::array<uint64_t, COUNT> hashes{};
+        std::array<size_t, BUCKETS> sizes{};
+        for (size_t i = 0; i < COUNT; ++i) {
+            hashes[i] = hashName(NAMES[i]);
+            ++sizes[(hashes[i] >> 32) & (BUCKETS - 1)];
+        }
+        // Fullest buckets first, while the table still has room
+        for (size_t size = COUNT; size > 0; --size) {
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                if (sizes[bucket] != size) {
+                    continue;
+                }
+                for (uint32_t displacement = 0;; ++displacement) {
+                    std::array<size_t, COUNT> placed{};
+                    size_t count = 0;
+                    bool fits = true;
+                    for (size_t i = 0; i < COUNT && fits; ++i) {
+                        if (((hashes[i] >> 32) & (BUCKETS - 1)) != bucket) {
+                            continue;
+                        }
+                        const size_t slot = slotOf(hashes[i], displacement);
+                        fits = table.ids[slot] < 0;
+                        for (size_t j = 0; j < count && fits; ++j) {
+                            fits = placed[j] != slot;
+                        }
+                        placed[count++] = slot;
+                    }
+                    if (fits) {
+                        table.displacements[bucket] = displacement;
+                        for (size_t i = 0, j = 0; i < COUNT; ++i) {
+                            if (((hashes[i] >> 32) & (BUCKETS - 1)) == bucket) {
+                                table.ids[placed[j++]] = static_cast<int>(i);
+                            }
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        return table;
+    }
+
+    static constexpr Table TABLE{ build() };
+
+public:
+    static constexpr int find(const std::string_view name) {
+        const uint64_t hash = hashName(name);
+        const int id = TABLE.ids[slotOf(hash, TABLE.displacements[(hash >> 32) & (BUCKETS - 1)])];
+        return id >= 0 && NAMES[id] == name ? id : -1;
+    }
+};
+
+// A name usable as a StaticNameIndex key, for names that are not string
+// literals (generated field names)
+template <size_t N>
+struct FieldName {
+    char data[N]{};
+    constexpr FieldName(const char (&text)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            data[i] = text[i];
+        }
+    }
+    constexpr FieldName() = default;
+};
+
+// The baseline: fmt's own linear scan over the named arguments
+struct LinearNameIndex {
+    fmt::format_args args;
+    int find(const std::string_view name) const { return args.get_id(fmt::string_view(name)); }
+};
+
+// fmt's format handler with named arguments resolved through the index
+template <typename Index>
+struct IndexedFormatHandler : fmt::detail::format_handler<char> {
+    const Index& index;
+
+    using fmt::detail::format_handler<char>::on_arg_id;
+    int on_arg_id(const fmt::string_view name) {
+        parse_ctx.check_arg_id(name);
+        const int id = index.find(std::string_view(name.data(), name.size()));
+        if (id < 0) {
+            fmt::report_error("argument not found");
+        }
+        return id;
+    }
+};
+
+// fmt::vformat_to with named arguments looked up in index, which must map
+// each name to its id in args
+template <typename Index>
+void vformatIndexed(fmt::detail::buffer<char>& buffer, const fmt::string_view format,
+    const fmt::format_args args, const Index& index) {
+    FMT_STAGE_PROBE(parse);
+    IndexedFormatHandler<Index> handler{
+        { fmt::parse_context<char>(format), fmt::context(fmt::appender(buffer), args) }, index };
+    fmt::detail::parse_format_string(format, handler);
+}
+
+#if FMT_USE_NONTYPE_TEMPLATE_ARGS
+template <typename T>
+struct StaticArgName;
+
+template <typename T, typename Char, size_t N, fmt::detail::fixed_string<Char, N> Str>
+struct StaticArgName<fmt::detail::static_named_arg<T, Char, N, Str>> {
+    static constexpr auto value = Str;
+};
+
+// fmt::format_to(appender, format, "name"_a = value, ...) with the names
+// indexed at compile time; every argument must be a static "name"_a one
+template <typename... T>
+void formatStaticNamed(fmt::memory_buffer& buffer, const fmt::string_view format, T&&... args) {
+    using Index = StaticNameIndex<StaticArgName<std::remove_cvref_t<T>>::value...>;
+    vformatIndexed(buffer, format, fmt::make_format_args(args...), Index{});
+}
+#endif
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "fmt/format.h"
+#include <string_view>
+#include <vector>
+
+// Platform names padded to a fixed column, as in the operator-facing
+// reports. Any width or precision makes fmt measure the display width of
+// the string; pure-ASCII runs are measured by their size and only the
+// non-ASCII spans are decoded code point by code point. That code is in the
+// vendored fmt/format.h, reached through detail::vformat_to, so it runs
+// because the project builds fmt header-only (FMT_HEADER_ONLY); a prebuilt
+// fmt.lib would measure its own copy. state.range(0) picks the names:
+// 0 ASCII, 1 Latin-1 letters in UTF-8 (mostly ASCII with a few two-byte
+// sequences), 2 CJK (three-byte sequences of width 2).
+class PaddedNameFixture : public benchmark::Fixture {
+public:
+    std::vector<std::string_view> names;
+    char out[256]{};
+
+    void SetUp(const ::benchmark::State& state) override {
+        static const std::vector<std::vector<std::string_view>> NAMES = {
+            { "Alpha Battery", "Bravo Launcher 7", "Charlie Forward Observation Post",
+              "Echo Mobile Radar Section North" },
+            // "Müller Straße Batterie", "Zürich Relaisstation Süd", "Gävle Förrådsbyggnad",
+            // "Tromsø Kystradar Nord"
+            { "M\xC3\xBCller Stra\xC3\x9F" "e Batterie", "Z\xC3\xBCrich Relaisstation S\xC3\xBC" "d",
+              "G\xC3\xA4vle F\xC3\xB6rr\xC3\xA5" "dsbyggnad", "Troms\xC3\xB8 Kystradar Nord" },
+            // "東京第一観測所", "大阪中継局", "北海道沿岸レーダー北", "名古屋前方監視所"
+            { "\xE6\x9D\xB1\xE4\xBA\xAC\xE7\xAC\xAC\xE4\xB8\x80\xE8\xA6\xB3\xE6\xB8\xAC\xE6\x89\x80",
+              "\xE5\xA4\xA7\xE9\x98\xAA\xE4\xB8\xAD\xE7\xB6\x99\xE5\xB1\x80",
+              "\xE5\x8C\x97\xE6\xB5\xB7\xE9\x81\x93\xE6\xB2\xBF\xE5\xB2\xB8\xE3\x83\xAC\xE3\x83\xBC"
+              "\xE3\x83\x80\xE3\x83\xBC\xE5\x8C\x97",
+              "\xE5\x90\x8D\xE5\x8F\xA4\xE5\xB1\x8B\xE5\x89\x8D\xE6\x96\xB9\xE7\x9B\xA3\xE8\xA6\x96"
+              "\xE6\x89\x80" }
+        };
+        names = NAMES[static_cast<size_t>(state.range(0))];
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        names.clear();
+    }
+};
+
+static void nameKindArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("names")->DenseRange(0, 2);
+}
+
+// No width: the name is copied without measuring it, the floor for the rest
+BENCHMARK_DEFINE_F(PaddedNameFixture, GML_name_unpadded)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto name = names[idx++ % names.size()];
+        char* end = fmt::format_to(out, ";$Platform Name:$ {}", name);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(PaddedNameFixture, GML_name_unpadded)->Apply(nameKindArgs);
+
+BENCHMARK_DEFINE_F(PaddedNameFixture, GML_name_padded)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto name = names[idx++ % names.size()];
+        char* end = fmt::format_to(out, ";$Platform Name:$ {:<32}", name);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(PaddedNameFixture, GML_name_padded)->Apply(nameKindArgs);
+
+// Padded and cut to 24 columns: the precision bounds the ASCII scan
+BENCHMARK_DEFINE_F(PaddedNameFixture, GML_name_truncated)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto name = names[idx++ % names.size()];
+        char* end = fmt::format_to(out, ";$Platform Name:$ {:<32.24}", name);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(PaddedNameFixture, GML_name_truncated)->Apply(nameKindArgs);
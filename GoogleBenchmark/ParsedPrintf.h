@@ -0,0 +1,202 @@
+#pragma once
+#include "fmt/printf.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A printf format string parsed once, for fmt::sprintf call sites whose
+// strings are only known at runtime or too many to translate by hand (see
+// PrintfCompile.h for literals). fmt::detail::vprintf parses flags, width,
+// precision and length modifier on every call; here they are parsed into
+// format_specs up front. A conversion whose argument has the type it
+// expects (%d of an int, %s of a string, %.3f of a double) is written
+// straight from those specs. Any other conversion, and every conversion of
+// a format using '*' or '$', is handed back to vprintf, so the output is
+// always fmt::sprintf's.
+class ParsedPrintf {
+public:
+    explicit ParsedPrintf(const std::string_view format) : format(format) {
+        const char* begin = format.data();
+        const char* end = begin + format.size();
+        const char* literal = begin;
+        for (const char* it = begin; it != end;) {
+            if (*it != '%') {
+                ++it;
+                continue;
+            }
+            if (it + 1 != end && it[1] == '%') {
+                ops.push_back({ offset(literal), static_cast<size_t>(it + 1 - literal) });
+                literal = it += 2;
+                continue;
+            }
+            Op op{ offset(literal), static_cast<size_t>(it - literal) };
+            op.conversionBegin = offset(it);
+            parseConversion(op, ++it, end);
+            op.conversionSize = offset(it) - op.conversionBegin;
+            ops.push_back(op);
+            literal = it;
+        }
+        if (literal != end || ops.empty()) {
+            ops.push_back({ offset(literal), static_cast<size_t>(end - literal) });
+        }
+    }
+
+    void formatTo(fmt::detail::buffer<char>& buffer, const fmt::printf_args args) const {
+        if (dynamic) {
+            fmt::detail::vprintf(buffer, fmt::string_view(format.data(), format.size()), args);
+            return;
+        }
+        auto out = fmt::appender(buffer);
+        auto context = fmt::printf_context(out, args);
+        int next = 0;
+        for (const auto& op : ops) {
+            buffer.append(format.data() + op.literalBegin, format.data() + op.literalBegin + op.literalSize);
+            if (op.conversionSize == 0) {
+                continue;
+            }
+            const auto arg = args.get(next++);
+            if (!arg) {
+                fmt::report_error("argument not found");
+            }
+            bool upper = false;
+            if (op.fast && fmt::detail::printf_fast_type(op.conversion, arg.type(), upper) != fmt::presentation_type::none) {
+                auto specs = op.specs;
+                arg.visit(fmt::detail::printf_arg_formatter<char>(out, specs, context));
+            } else {
+                fmt::detail::vprintf(buffer, fmt::string_view(format.data() + op.conversionBegin, op.conversionSize),
+                    fmt::printf_args(&arg, 1));
+            }
+        }
+    }
+
+    const std::string& text() const { return format; }
+
+private:
+    // Literal text followed by the conversion (if any) after it
+    struct Op {
+        size_t literalBegin;
+        size_t literalSize;
+        size_t conversionBegin{ 0 };
+        size_t conversionSize{ 0 };  // 0: literal only
+        fmt::format_specs specs{};
+        char conversion{ '\0' };
+        bool fast{ false };  // specs hold the final specs for a matching argument
+    };
+
+    size_t offset(const char* p) const { return static_cast<size_t>(p - format.data()); }
+
+    // Parses the conversion after '%' the way vprintf does, and resolves
+    // the specs vprintf would build for an argument of the expected type
+    void parseConversion(Op& op, const char*& it, const char* end) {
+        auto& specs = op.specs;
+        specs.set_align(fmt::align::right);
+        fmt::detail::parse_flags(specs, it, end);
+        if (it != end && *it >= '0' && *it <= '9') {
+            specs.width = fmt::detail::parse_nonnegative_int(it, end, -1);
+            if (specs.width == -1) {
+                fmt::report_error("number is too big");
+            }
+        }
+        if (it != end && (*it == '*' || *it == '$')) {
+            dynamic = true;
+        }
+        if (it != end && *it == '.') {
+            ++it;
+            if (it != end && *it == '*') {
+                dynamic = true;
+            }
+            specs.precision = it != end && *it >= '0' && *it <= '9' ? fmt::detail::parse_nonnegative_int(it, end, 0) : 0;
+        }
+        bool length = false;
+        while (it != end && (*it == 'h' || *it == 'l' || *it == 'j' || *it == 'z' || *it == 't' || *it == 'L' ||
+            *it == '*' || *it == '$' || *it == '.' || (*it >= '0' && *it <= '9'))) {
+            length = true;
+            ++it;
+        }
+        if (it == end) {
+            fmt::report_error("invalid format string");
+        }
+        op.conversion = *it++;
+
+        // The kind of argument the conversion expects decides what vprintf
+        // does with the flags. Integer precision, '#' on integers and a
+        // precision on strings depend on the value, so vprintf keeps those.
+        bool upper = false;
+        fmt::detail::type expected;
+        switch (op.conversion) {
+        case 'd': case 'i': expected = fmt::detail::type::int_type; break;
+        case 'u': expected = fmt::detail::type::uint_type; break;
+        case 's': expected = fmt::detail::type::cstring_type; break;
+        default: expected = fmt::detail::type::double_type; break;
+        }
+        const auto type = fmt::detail::printf_fast_type(op.conversion, expected, upper);
+        const bool integer = fmt::detail::is_integral_type(expected);
+        const bool arithmetic = fmt::detail::is_arithmetic_type(expected);
+        op.fast = !length && type != fmt::presentation_type::none && !(integer && specs.precision >= 0) &&
+            !(integer && specs.alt()) && !(expected == fmt::detail::type::cstring_type && specs.precision >= 0);
+        if (!op.fast) {
+            return;
+        }
+        if (specs.fill_unit<char>() == '0') {
+            if (arithmetic && specs.align() != fmt::align::left) {
+                specs.set_align(fmt::align::numeric);
+            } else {
+                specs.set_fill(' ');
+            }
+        }
+        specs.set_type(type);
+        if (upper) {
+            specs.set_upper();
+        }
+    }
+
+    std::string format;
+    std::vector<Op> ops;
+    bool dynamic{ false };  // '*' width or precision, or '$' argument indices
+};
+
+// Parsed formats keyed by the format string's address, as
+// CompiledFormatCache: each string is parsed on first use, and a hit is
+// checked against the parsed text, since a runtime format may be built in a
+// reused or stack buffer that comes back at the same address with other
+// text. Not synchronized: one cache per thread, or fill it at startup.
+class PrintfFormatCache {
+public:
+    const ParsedPrintf& get(const char* format) {
+        auto& parsed = formats[format];
+        if (!parsed || parsed->text() != format) {
+            parsed = std::make_unique<ParsedPrintf>(format);
+        }
+        return *parsed;
+    }
+
+    // fmt::sprintf through the cache
+    template <typename... T>
+    std::string sprintf(const char* format, const T&... args) {
+        fmt::memory_buffer buffer;
+        get(format).formatTo(buffer, fmt::make_printf_args(args...));
+        return fmt::to_string(buffer);
+    }
+
+    // Same contract as snprintf, for sprintf_s call sites: writes at most
+    // size - 1 characters and a terminating null, and returns the length the
+    // whole output would have
+    template <typename... T>
+    int snprintf(char* dst, const size_t size, const char* format, const T&... args) {
+        fmt::detail::iterator_buffer<char*, char, fmt::detail::fixed_buffer_traits> out(dst, size != 0 ? size - 1 : 0);
+        get(format).formatTo(out, fmt::make_printf_args(args...));
+        const size_t written = out.count();
+        char* end = out.out();
+        if (size != 0) {
+            *end = '\0';
+        }
+        return static_cast<int>(written);
+    }
+
+    size_t size() const { return formats.size(); }
+
+private:
+    std::unordered_map<const char*, std::unique_ptr<ParsedPrintf>> formats;
+};
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+
+// BM_StringConcat and BM_ReserveAppend with the allocation source swapped
+// out, to split each method's cost into allocator and formatting. Every
+// benchmark thread owns its own resource, so the pmr variants never
+// synchronize; the heap variant shares the global allocator.
+
+// Global heap via std::string, as the original methods
+struct HeapStrings {
+    using String = std::string;
+    String make(const char* text) { return String(text); }
+    void endIteration() {}
+};
+
+// Bump allocation out of a stack arena, released every BATCH iterations.
+// Deallocation is a no-op, so a batch only ever moves the pointer forward.
+struct MonotonicStrings {
+    static constexpr size_t BATCH{ 256 };
+    using String = std::pmr::string;
+
+    alignas(std::max_align_t) std::array<std::byte, 64 * 1'024> arena;
+    std::pmr::monotonic_buffer_resource resource{ arena.data(), arena.size() };
+    size_t iterations{ 0 };
+
+    String make(const char* text) { return String(text, &resource); }
+    void endIteration() {
+        if (++iterations == BATCH) {
+            iterations = 0;
+            resource.release();
+        }
+    }
+};
+
+// Size-class free lists; freed blocks are reused by the next iteration
+struct PoolStrings {
+    using String = std::pmr::string;
+
+    std::pmr::unsynchronized_pool_resource resource;
+
+    String make(const char* text) { return String(text, &resource); }
+    void endIteration() {}
+};
+
+// Method 2: String concatenation with std::to_string
+template <class Strings>
+static void BM_StringConcat_Alloc(benchmark::State& state) {
+    int id = 12345;
+    double price = 99.99;
+    const char* name = "Widget";
+    Strings strings;
+
+    for (auto _ : state) {
+        {
+            auto result = strings.make("Product: ") + name +
+                ", ID: " + std::to_string(id).c_str() +
+                ", Price: $" + std::to_string(price).c_str();
+            benchmark::DoNotOptimize(result);
+        }
+        strings.endIteration();
+    }
+}
+BENCHMARK_TEMPLATE(BM_StringConcat_Alloc, HeapStrings)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StringConcat_Alloc, MonotonicStrings)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StringConcat_Alloc, PoolStrings)->ThreadRange(1, 8)->UseRealTime();
+
+// Method 5: Reserve + append (manual optimization)
+template <class Strings>
+static void BM_ReserveAppend_Alloc(benchmark::State& state) {
+    int id = 12345;
+    double price = 99.99;
+    const char* name = "Widget";
+    Strings strings;
+
+    for (auto _ : state) {
+        {
+            auto result = strings.make("");
+            result.reserve(64);  // Pre-allocate
+            result += "Product: ";
+            result += name;
+            result += ", ID: ";
+            result += std::to_string(id).c_str();
+            result += ", Price: $";
+            result += std::to_string(price).c_str();
+            benchmark::DoNotOptimize(result);
+        }
+        strings.endIteration();
+    }
+}
+BENCHMARK_TEMPLATE(BM_ReserveAppend_Alloc, HeapStrings)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReserveAppend_Alloc, MonotonicStrings)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReserveAppend_Alloc, PoolStrings)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "GmlSerializer.h"
+#include "ParsedPrintf.h"
+#include "PrintfCompile.h"
+#include "SampleData.h"
+#include "fmt/printf.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The GML_sprintf_length record, field by field with the legacy printf
+// strings, through sprintf_s, fmt::sprintf, the parsed-format cache and the
+// compiled translation
+class PrintfFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    char out[MAX_SAMPLE_SIZE + GML_HEADROOM]{};
+
+    void SetUp(const ::benchmark::State& /*state*/) override {
+        samples = makeSamples(1'024);
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(PrintfFixture, GML_printf_sprintf_s)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        size_t length = 0;
+        length += sprintf_s(out + length, sizeof(out) - length, ";$Flag Value:$ %s", yesOrNo);
+        length += sprintf_s(out + length, sizeof(out) - length, ";$Launcher ID:$ %d", s.id);
+        length += sprintf_s(out + length, sizeof(out) - length, ";$Predicted Intercept Range:$ %.3f dm", s.value);
+        length += sprintf_s(out + length, sizeof(out) - length, ";$Platform Name:$ %s", s.name);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK_REGISTER_F(PrintfFixture, GML_printf_sprintf_s);
+
+// fmt's printf implementation: parsed at runtime, a std::string per field
+BENCHMARK_DEFINE_F(PrintfFixture, GML_printf_fmt_sprintf)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        size_t length = 0;
+        for (const auto& field : {
+                 fmt::sprintf(";$Flag Value:$ %s", yesOrNo),
+                 fmt::sprintf(";$Launcher ID:$ %d", s.id),
+                 fmt::sprintf(";$Predicted Intercept Range:$ %.3f dm", s.value),
+                 fmt::sprintf(";$Platform Name:$ %s", s.name) }) {
+            std::memcpy(out + length, field.data(), field.size() + 1);
+            length += field.size();
+        }
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK_REGISTER_F(PrintfFixture, GML_printf_fmt_sprintf);
+
+// Runtime strings parsed once: the same bounded, null-terminated contract
+// as sprintf_s
+BENCHMARK_DEFINE_F(PrintfFixture, GML_printf_cached)(benchmark::State& state) {
+    PrintfFormatCache cache;
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        size_t length = 0;
+        length += cache.snprintf(out + length, sizeof(out) - length, ";$Flag Value:$ %s", yesOrNo);
+        length += cache.snprintf(out + length, sizeof(out) - length, ";$Launcher ID:$ %d", s.id);
+        length += cache.snprintf(out + length, sizeof(out) - length, ";$Predicted Intercept Range:$ %.3f dm", s.value);
+        length += cache.snprintf(out + length, sizeof(out) - length, ";$Platform Name:$ %s", s.name);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK_REGISTER_F(PrintfFixture, GML_printf_cached);
+
+// Drop-in for the sprintf_s call sites: bounded, null-terminated
+BENCHMARK_DEFINE_F(PrintfFixture, GML_printf_compiled)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        size_t length = 0;
+        length += sprintfCompiled(out + length, sizeof(out) - length, ";$Flag Value:$ %s"_printf, yesOrNo);
+        length += sprintfCompiled(out + length, sizeof(out) - length, ";$Launcher ID:$ %d"_printf, s.id);
+        length += sprintfCompiled(out + length, sizeof(out) - length,
+            ";$Predicted Intercept Range:$ %.3f dm"_printf, s.value);
+        length += sprintfCompiled(out + length, sizeof(out) - length, ";$Platform Name:$ %s"_printf, s.name);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK_REGISTER_F(PrintfFixture, GML_printf_compiled);
+
+// Unbounded, into a buffer sized for the record
+BENCHMARK_DEFINE_F(PrintfFixture, GML_printf_compiled_to)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto& s = samples[idx++ % samples.size()];
+        const auto yesOrNo = (s.flag == 0) ? "No" : "Yes";
+        char* end = sprintfCompiledTo(out, ";$Flag Value:$ %s"_printf, yesOrNo);
+        end = sprintfCompiledTo(end, ";$Launcher ID:$ %d"_printf, s.id);
+        end = sprintfCompiledTo(end, ";$Predicted Intercept Range:$ %.3f dm"_printf, s.value);
+        end = sprintfCompiledTo(end, ";$Platform Name:$ %s"_printf, s.name);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(PrintfFixture, GML_printf_compiled_to);
@@ -0,0 +1,279 @@
+#pragma once
+#include "fmt/compile.h"
+#include "fmt/format.h"
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// printf format literals compiled into fmt's compiled-format chains, so
+// legacy sprintf_s call sites keep their strings:
+//   sprintf_s(dst, size, ";$Launcher ID:$ %d", id)
+// becomes
+//   sprintfCompiled(dst, size, ";$Launcher ID:$ %d"_printf, id)
+// The literal is translated at compile time into the fmt format string that
+// prints the same text (";$Launcher ID:$ {}"), which fmt/compile.h turns
+// into a text/field chain, and each argument is checked against its
+// conversion. Conversions are d i u o x X e E f F g G c s with the flags
+// - + space # 0, a width, a precision and any length modifier (the
+// argument's own type decides the size); as in printf, + and space only
+// affect %d, %i and the floating-point conversions. Integer arguments get printf's
+// default promotions: a char or short is promoted to int, and the result
+// is read as signed for %d and %i and as unsigned for %u, %o and %x, so
+// %x of the char 0x80 prints "ffffff80" and %d of 4000000000u prints
+// "-294967296". '*' widths, positional arguments, %a, %n and a precision on
+// integers have no fmt equivalent, and %p prints a form of its own in each
+// C runtime (16 uppercase digits on MSVC x64, "(nil)" for null in glibc);
+// all of these fail to compile. One difference remains: "%#x" of 0 prints
+// "0x0" where printf prints "0".
+#if FMT_USE_NONTYPE_TEMPLATE_ARGS
+
+template <size_t N>
+struct PrintfTranslation {
+    // "%d" is as long as "{}"; a width or precision adds "{:" and "}" for
+    // '%' and the conversion, and each brace doubles: never more than 2N
+    char text[2 * N]{};
+    size_t size{ 0 };
+    char conversions[N]{};
+    size_t count{ 0 };
+
+    constexpr void append(const char c) { text[size++] = c; }
+};
+
+consteval bool isPrintfDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+template <size_t N>
+consteval PrintfTranslation<N> translatePrintf(const char (&format)[N]) {
+    PrintfTranslation<N> result;
+    const size_t end = N - 1;
+    for (size_t i = 0; i < end; ++i) {
+        const char c = format[i];
+        if (c == '{' || c == '}') {
+            result.append(c);
+            result.append(c);
+            continue;
+        }
+        if (c != '%') {
+            result.append(c);
+            continue;
+        }
+        if (++i == end) {
+            throw "'%' at the end of the format";
+        }
+        if (format[i] == '%') {
+            result.append('%');
+            continue;
+        }
+
+        bool left = false, plus = false, space = false, alt = false, zero = false;
+        for (;; ++i) {
+            const char flag = format[i];
+            if (flag == '-') {
+                left = true;
+            } else if (flag == '+') {
+                plus = true;
+            } else if (flag == ' ') {
+                space = true;
+            } else if (flag == '#') {
+                alt = true;
+            } else if (flag == '0') {
+                zero = true;
+            } else {
+                break;
+            }
+        }
+        const size_t widthBegin = i;
+        while (isPrintfDigit(format[i])) {
+            ++i;
+        }
+        if (format[i] == '*' || format[i] == '$') {
+            throw "'*' widths and positional arguments are not supported";
+        }
+        const size_t widthEnd = i;
+        size_t precisionBegin = i;
+        bool precision = false;
+        if (format[i] == '.') {
+            precision = true;
+            precisionBegin = ++i;
+            if (format[i] == '*') {
+                throw "'*' precisions are not supported";
+            }
+            while (isPrintfDigit(format[i])) {
+                ++i;
+            }
+        }
+        const size_t precisionEnd = i;
+        while (format[i] == 'h' || format[i] == 'l' || format[i] == 'L' || format[i] == 'z' ||
+            format[i] == 'j' || format[i] == 't' || format[i] == 'q') {
+            ++i;
+        }
+
+        char type = format[i];
+        const bool integer = type == 'd' || type == 'i' || type == 'u' || type == 'o' || type == 'x' || type == 'X';
+        const bool text = type == 'c' || type == 's';
+        const bool floating = type == 'e' || type == 'E' || type == 'f' || type == 'F' || type == 'g' ||
+            type == 'G';
+        if (type == 'p') {
+            throw "%p prints differently in each C runtime; format the address explicitly";
+        }
+        if (!integer && !text && !floating) {
+            throw "unsupported printf conversion";
+        }
+        if (integer && precision) {
+            throw "a precision on integers has no fmt equivalent";
+        }
+        result.conversions[result.count++] = type;
+        // '+' and ' ' only apply to signed conversions; printf ignores them
+        // elsewhere and fmt rejects a sign on unsigned, char and string values
+        const bool sign = (plus || space) && (type == 'd' || type == 'i' || floating);
+        if (type == 'd' || type == 'i' || type == 'u' || type == 's') {
+            type = '\0';  // fmt's default presentation for the argument's type
+        }
+
+        // printf right-aligns everything unless '-'. fmt left-aligns text,
+        // inf and nan by default, but drops the '0' flag once an alignment
+        // is given, so zero-padded numbers keep the default.
+        const bool hasWidth = widthEnd != widthBegin;
+        const char align = left ? '<' : (hasWidth && (text || (floating && !zero)) ? '>' : '\0');
+        const bool hasSpecs = align != '\0' || sign || alt || (zero && !left && !text) || hasWidth ||
+            precision || type != '\0';
+        result.append('{');
+        if (hasSpecs) {
+            result.append(':');
+            if (align != '\0') {
+                result.append(align);
+            }
+            if (sign && plus) {
+                result.append('+');
+            } else if (sign) {
+                result.append(' ');
+            }
+            if (alt) {
+                result.append('#');
+            }
+            if (zero && !left && !text) {
+                result.append('0');
+            }
+            for (size_t d = widthBegin; d < widthEnd; ++d) {
+                result.append(format[d]);
+            }
+            if (precision) {
+                result.append('.');
+                if (precisionEnd == precisionBegin) {
+                    result.append('0');
+                }
+                for (size_t d = precisionBegin; d < precisionEnd; ++d) {
+                    result.append(format[d]);
+                }
+            }
+            if (type != '\0') {
+                result.append(type);
+            }
+        }
+        result.append('}');
+    }
+    return result;
+}
+
+template <typename T>
+constexpr bool printfArgMatches(const char conversion) {
+    using U = std::remove_cvref_t<std::decay_t<T>>;
+    switch (conversion) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        return std::is_integral_v<U> && !std::is_same_v<U, bool>;
+    case 'c':
+        return std::is_integral_v<U> && !std::is_same_v<U, bool>;
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+        return std::is_floating_point_v<U>;
+    case 's':
+        return std::is_same_v<U, const char*> || std::is_same_v<U, char*> ||
+            std::is_convertible_v<const U&, fmt::string_view>;
+    default:
+        return false;
+    }
+}
+
+// A printf literal as an fmt compiled string: fmt::format_to(out, format,
+// args...) with a PrintfFormat runs the compiled chain of its translation
+template <fmt::detail::fixed_string Printf>
+struct PrintfFormat : fmt::compiled_string {
+    using char_type = char;
+    static constexpr auto TRANSLATION = translatePrintf(Printf.data);
+
+    constexpr explicit operator fmt::string_view() const { return { TRANSLATION.text, TRANSLATION.size }; }
+
+    template <typename... T>
+    static consteval bool matches() {
+        if (sizeof...(T) != TRANSLATION.count) {
+            return false;
+        }
+        size_t i = 0;
+        return (printfArgMatches<T>(TRANSLATION.conversions[i++]) && ...);
+    }
+
+    // printf promotes integer arguments to at least int, then reads %d and
+    // %i as signed and %u, %o and %x as unsigned of that size
+    template <size_t I, typename T>
+    static constexpr decltype(auto) argument(const T& value) {
+        constexpr char conversion = TRANSLATION.conversions[I];
+        if constexpr (std::is_integral_v<T> && (conversion == 'd' || conversion == 'i')) {
+            return static_cast<std::make_signed_t<decltype(+value)>>(value);
+        } else if constexpr (std::is_integral_v<T> &&
+            (conversion == 'u' || conversion == 'o' || conversion == 'x' || conversion == 'X')) {
+            return static_cast<std::make_unsigned_t<decltype(+value)>>(+value);
+        } else {
+            return (value);
+        }
+    }
+
+    template <typename OutputIt, typename... T, size_t... I>
+    static OutputIt formatTo(OutputIt out, std::index_sequence<I...>, const T&... args) {
+        return fmt::format_to(out, PrintfFormat{}, argument<I>(args)...);
+    }
+};
+
+inline namespace printf_literals {
+template <fmt::detail::fixed_string Printf>
+constexpr auto operator""_printf() {
+    return PrintfFormat<Printf>{};
+}
+}  // namespace printf_literals
+
+// Same contract as snprintf: writes at most size - 1 characters and a
+// terminating null, and returns the length the whole output would have
+template <fmt::detail::fixed_string Printf, typename... T>
+int sprintfCompiled(char* buffer, const size_t size, PrintfFormat<Printf> /*format*/, const T&... args) {
+    static_assert(PrintfFormat<Printf>::template matches<T...>(),
+        "arguments do not match the printf conversions");
+    fmt::detail::iterator_buffer<char*, char, fmt::detail::fixed_buffer_traits> out(
+        buffer, size != 0 ? size - 1 : 0);
+    PrintfFormat<Printf>::formatTo(fmt::appender(out), std::index_sequence_for<T...>{}, args...);
+    const size_t written = out.count();
+    char* end = out.out();
+    if (size != 0) {
+        *end = '\0';
+    }
+    return static_cast<int>(written);
+}
+
+// Writes the whole output at dst and returns its end, for buffers sized
+// for the record: the compiled chain with no bounds check
+template <fmt::detail::fixed_string Printf, typename... T>
+char* sprintfCompiledTo(char* dst, PrintfFormat<Printf> /*format*/, const T&... args) {
+    static_assert(PrintfFormat<Printf>::template matches<T...>(),
+        "arguments do not match the printf conversions");
+    return PrintfFormat<Printf>::formatTo(dst, std::index_sequence_for<T...>{}, args...);
+}
+
+// fmt::sprintf through the compiled chain
+template <fmt::detail::fixed_string Printf, typename... T>
+std::string sprintfCompiled(PrintfFormat<Printf> /*format*/, const T&... args) {
+    static_assert(PrintfFormat<Printf>::template matches<T...>(),
+        "arguments do not match the printf conversions");
+    std::string result;
+    PrintfFormat<Printf>::formatTo(std::back_inserter(result), std::index_sequence_for<T...>{}, args...);
+    return result;
+}
+#endif
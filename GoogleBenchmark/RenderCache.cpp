@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "RenderCache.h"
+#include "SampleData.h"
+#include <random>
+#include <vector>
+
+static constexpr size_t CACHE_CAPACITY{ 1'024 };
+static constexpr size_t CACHE_HOT_RECORDS{ 256 };
+static constexpr size_t CACHE_STREAM{ 16'384 };
+
+// A feed of CACHE_STREAM records in which state.range(0) percent are re-sends
+// of a small hot set and the rest are distinct records. The distinct records
+// far outnumber the cache, so they miss on every pass through the feed.
+class RenderCacheFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> records;
+    std::vector<uint32_t> stream;
+    std::vector<char> out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        records = makeSamples(CACHE_HOT_RECORDS + CACHE_STREAM);
+        for (size_t i = 0; i < records.size(); ++i) {
+            records[i].id = static_cast<int>(i);  // Every record distinct
+        }
+        std::mt19937 rng(42);
+        std::bernoulli_distribution resend(static_cast<double>(state.range(0)) / 100.0);
+        std::uniform_int_distribution<uint32_t> hot(0, CACHE_HOT_RECORDS - 1);
+        stream.resize(CACHE_STREAM);
+        uint32_t nextCold = CACHE_HOT_RECORDS;
+        for (auto& r : stream) {
+            r = resend(rng) ? hot(rng) : nextCold++;
+        }
+        out.assign(MAX_SAMPLE_SIZE + GML_HEADROOM, '\0');
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        records.clear();
+        stream.clear();
+        out.clear();
+    }
+};
+
+static void hitRateArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("resend%")->Arg(0)->Arg(50)->Arg(90)->Arg(99)->Arg(100);
+}
+
+BENCHMARK_DEFINE_F(RenderCacheFixture, GML_fmt_format_to_uncached)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = writeSample(out.data(), records[stream[idx++ % stream.size()]]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(RenderCacheFixture, GML_fmt_format_to_uncached)->Apply(hitRateArgs);
+
+BENCHMARK_DEFINE_F(RenderCacheFixture, GML_render_cache)(benchmark::State& state) {
+    RenderCache cache(CACHE_CAPACITY);
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = cache.write(out.data(), records[stream[idx++ % stream.size()]]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.counters["hit%"] = 100.0 * static_cast<double>(cache.hits()) / static_cast<double>(cache.hits() + cache.misses());
+}
+BENCHMARK_REGISTER_F(RenderCacheFixture, GML_render_cache)->Apply(hitRateArgs);
@@ -0,0 +1,149 @@
+#pragma once
+#include "FixedString.h"
+#include "GmlSerializer.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Fast non-cryptographic hash of a record's meaningful bytes: flag, id, the
+// value's bit pattern and the name up to its terminator. Padding and the
+// bytes after the name are ignored, so records that render the same hash the
+// same. Word-at-a-time with a splitmix-style finalizer per word.
+inline uint64_t mixHash(uint64_t x) {
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93ull;
+    x ^= x >> 32;
+    return x;
+}
+
+inline uint64_t hashSample(const Sample_t& sample, const size_t nameSize) {
+    uint64_t value;
+    std::memcpy(&value, &sample.value, sizeof(value));
+    uint64_t h = mixHash(0x9e3779b97f4a7c15ull ^ sample.flag ^ (uint64_t{ static_cast<uint32_t>(sample.id) } << 8));
+    h = mixHash(h ^ value);
+    size_t i = 0;
+    for (; i + 8 <= nameSize; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, sample.name + i, 8);
+        h = mixHash(h ^ word);
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, sample.name + i, nameSize - i);
+    return mixHash(h ^ tail ^ (uint64_t{ nameSize } << 56));
+}
+
+// Bounded cache of rendered GML records in front of the serializer. Lookups
+// go through an open-addressing index keyed by hashSample; a hit is confirmed
+// against the stored key bytes and served with one memcpy. When full, the
+// CLOCK hand picks the victim: referenced entries get a second chance,
+// the first unreferenced one is evicted.
+class RenderCache {
+public:
+    explicit RenderCache(const size_t capacity)
+        : entries(capacity), index(std::bit_ceil(capacity * 2), EMPTY), indexMask(index.size() - 1) {}
+
+    // Writes the GML for sample at dst (like writeSampleFragments) and
+    // returns the new end. dst needs GML_HEADROOM bytes of headroom.
+    char* write(char* dst, const Sample_t& sample) {
+        const size_t nameSize = boundedStrlen(sample.name);
+        const uint64_t hash = hashSample(sample, nameSize);
+        for (size_t slot = hash & indexMask; index[slot] != EMPTY; slot = (slot + 1) & indexMask) {
+            auto& entry = entries[index[slot]];
+            if (entry.hash == hash && entry.matches(sample, nameSize)) {
+                ++hitCount;
+                entry.referenced = true;
+                std::memcpy(dst, entry.text, entry.size);
+                return dst + entry.size;
+            }
+        }
+        ++missCount;
+        auto& entry = entries[evict()];
+        entry.hash = hash;
+        entry.referenced = true;
+        entry.flag = sample.flag;
+        entry.id = sample.id;
+        entry.value = sample.value;
+        entry.nameSize = static_cast<uint16_t>(nameSize);
+        std::memcpy(entry.name, sample.name, nameSize);
+        entry.size = static_cast<uint16_t>(writeSampleFragments(entry.text, sample) - entry.text);
+        insert(hash, static_cast<uint32_t>(&entry - entries.data()));
+        std::memcpy(dst, entry.text, entry.size);
+        return dst + entry.size;
+    }
+
+    size_t hits() const { return hitCount; }
+    size_t misses() const { return missCount; }
+
+private:
+    static constexpr uint32_t EMPTY{ UINT32_MAX };
+
+    struct Entry {
+        uint64_t hash{ 0 };
+        bool used{ false };
+        bool referenced{ false };
+        uint8_t flag{ 0 };
+        uint16_t nameSize{ 0 };
+        uint16_t size{ 0 };
+        int id{ 0 };
+        double value{ 0 };
+        char name[sizeof(Sample_t::name)];
+        char text[MAX_SAMPLE_SIZE + GML_HEADROOM];
+
+        bool matches(const Sample_t& sample, const size_t sampleNameSize) const {
+            return flag == sample.flag && id == sample.id &&
+                std::memcmp(&value, &sample.value, sizeof(value)) == 0 &&
+                nameSize == sampleNameSize && std::memcmp(name, sample.name, sampleNameSize) == 0;
+        }
+    };
+
+    // Returns a free entry, evicting with the CLOCK policy if needed
+    uint32_t evict() {
+        for (;;) {
+            auto& entry = entries[hand];
+            const auto victim = static_cast<uint32_t>(hand);
+            hand = (hand + 1) % entries.size();
+            if (!entry.used) {
+                entry.used = true;
+                return victim;
+            }
+            if (!entry.referenced) {
+                erase(entry.hash, victim);
+                return victim;
+            }
+            entry.referenced = false;
+        }
+    }
+
+    void insert(const uint64_t hash, const uint32_t entry) {
+        size_t slot = hash & indexMask;
+        while (index[slot] != EMPTY) {
+            slot = (slot + 1) & indexMask;
+        }
+        index[slot] = entry;
+    }
+
+    // Linear-probing delete with backward shift, so no tombstones build up
+    void erase(const uint64_t hash, const uint32_t entry) {
+        size_t slot = hash & indexMask;
+        while (index[slot] != entry) {
+            slot = (slot + 1) & indexMask;
+        }
+        for (size_t next = (slot + 1) & indexMask; index[next] != EMPTY; next = (next + 1) & indexMask) {
+            const size_t home = entries[index[next]].hash & indexMask;
+            // Move next into the hole unless its home lies cyclically in (slot, next]
+            if (((next - home) & indexMask) >= ((next - slot) & indexMask)) {
+                index[slot] = index[next];
+                slot = next;
+            }
+        }
+        index[slot] = EMPTY;
+    }
+
+    std::vector<Entry> entries;
+    std::vector<uint32_t> index;
+    size_t indexMask;
+    size_t hand{ 0 };
+    size_t hitCount{ 0 };
+    size_t missCount{ 0 };
+};
@@ -0,0 +1,210 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "SampleBatch.h"
+#include "SampleData.h"
+#include <charconv>
+#include <climits>
+#include <algorithm>
+#include <random>
+#include <string_view>
+#include <vector>
+
+// Exact serialized size of a batch, so the output buffer is allocated once
+static size_t serializedSize(const std::vector<Sample_t>& samples) {
+    char record[1'024];
+    size_t total = 0;
+    for (const auto& s : samples) {
+        total += static_cast<size_t>(writeSample(record, s) - record);
+    }
+    return total;
+}
+
+class SampleBatchFixture : public benchmark::Fixture {
+public:
+    std::vector<Sample_t> samples;
+    SampleBatch batch;
+    std::vector<char> out;
+
+    void SetUp(const ::benchmark::State& state) override {
+        samples = makeSamples(static_cast<size_t>(state.range(0)));
+        batch.assign(samples);
+        out.assign(serializedSize(samples) + 64, '\0');
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        samples = {};
+        batch = {};
+        out = {};
+    }
+};
+
+static void batchSizeArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("records")->RangeMultiplier(10)->Range(1'000, 10'000'000)->Unit(benchmark::kMillisecond);
+}
+
+// AoS baseline: writeSample over the Sample_t array
+BENCHMARK_DEFINE_F(SampleBatchFixture, GML_batch_aos)(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = out.data();
+        for (const auto& s : samples) {
+            pEnd = writeSample(pEnd, s);
+        }
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(SampleBatchFixture, GML_batch_aos)->Apply(batchSizeArgs);
+
+// AoS with the fragment-table flag and bounded name
+BENCHMARK_DEFINE_F(SampleBatchFixture, GML_batch_aos_fragments)(benchmark::State& state) {
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = out.data();
+        for (const auto& s : samples) {
+            pEnd = writeSampleFragments(pEnd, s);
+        }
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(SampleBatchFixture, GML_batch_aos_fragments)->Apply(batchSizeArgs);
+
+// Columnar batch, already converted
+BENCHMARK_DEFINE_F(SampleBatchFixture, GML_batch_soa)(benchmark::State& state) {
+    BatchSerializer serializer;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = serializer.write(out.data(), batch);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(SampleBatchFixture, GML_batch_soa)->Apply(batchSizeArgs);
+
+// Columnar batch including the conversion from span<Sample_t>
+BENCHMARK_DEFINE_F(SampleBatchFixture, GML_batch_soa_convert)(benchmark::State& state) {
+    BatchSerializer serializer;
+    SampleBatch converted;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        converted.assign(samples);
+        char* pEnd = serializer.write(out.data(), converted);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(SampleBatchFixture, GML_batch_soa_convert)->Apply(batchSizeArgs);
+
+// Id column to decimal, 4K ids per iteration spread over every digit count
+// and sign. Each kernel is first checked against std::to_chars on these ids
+// plus the edge values.
+class IdDigitsFixture : public benchmark::Fixture {
+public:
+    static constexpr size_t COUNT{ 4'096 };
+    std::vector<int> ids;
+    std::vector<DigitSlot> slots;
+    std::vector<char> out;
+
+    void SetUp(const ::benchmark::State& /*state*/) override {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> digitCount(1, 10);
+        ids.resize(COUNT);
+        for (auto& id : ids) {
+            long long limit = 1;
+            for (int digits = digitCount(rng); digits > 0; --digits) {
+                limit *= 10;
+            }
+            limit = std::min<long long>(limit - 1, INT_MAX);
+            id = static_cast<int>(std::uniform_int_distribution<long long>(0, limit)(rng));
+            id = rng() & 1 ? -id : id;
+        }
+        slots.resize(COUNT + 1);
+        out.resize(COUNT * 16);
+    }
+
+    // True if kernel matches std::to_chars on ids and the edge values
+    bool matchesToChars(const IdDigitsKernel kernel) {
+        std::vector<int> values{ 0, 1, -1, 9, -9, 10, -10, 99'999'999, 100'000'000, -100'000'000,
+            999'999'999, 1'000'000'000, INT_MAX, INT_MIN, INT_MIN + 1 };
+        values.insert(values.end(), ids.begin(), ids.end());
+        std::vector<DigitSlot> checked(values.size() + 1);
+        kernel(checked.data(), values.data(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            char expected[16];
+            const auto result = std::to_chars(expected, expected + sizeof(expected), values[i]);
+            const auto& slot = checked[i];
+            if (std::string_view(slot.text + slot.offset, slot.size) != std::string_view(expected, result.ptr)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void run(benchmark::State& state, const IdDigitsKernel kernel) {
+        if (!matchesToChars(kernel)) {
+            state.SkipWithError("output does not match std::to_chars");
+            return;
+        }
+        for (auto _ : state) {
+            kernel(slots.data(), ids.data(), ids.size());
+            char* pEnd = out.data();
+            for (size_t i = 0; i < ids.size(); ++i) {
+                pEnd = slots[i].copyTo(pEnd);
+            }
+            benchmark::DoNotOptimize(pEnd);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ids.size());
+    }
+};
+
+// Baseline: fmt's scalar format_decimal, through format_int
+BENCHMARK_DEFINE_F(IdDigitsFixture, GML_id_digits_fmt_format_int)(benchmark::State& state) {
+    for (auto _ : state) {
+        char* pEnd = out.data();
+        for (const int id : ids) {
+            const fmt::format_int text(id);
+            std::memcpy(pEnd, text.data(), text.size());
+            pEnd += text.size();
+        }
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK_REGISTER_F(IdDigitsFixture, GML_id_digits_fmt_format_int);
+
+BENCHMARK_DEFINE_F(IdDigitsFixture, GML_id_digits_scalar)(benchmark::State& state) {
+    run(state, idDigitsScalar);
+}
+BENCHMARK_REGISTER_F(IdDigitsFixture, GML_id_digits_scalar);
+
+#if GML_X86
+BENCHMARK_DEFINE_F(IdDigitsFixture, GML_id_digits_sse2)(benchmark::State& state) {
+    run(state, idDigitsSse2);
+}
+BENCHMARK_REGISTER_F(IdDigitsFixture, GML_id_digits_sse2);
+
+BENCHMARK_DEFINE_F(IdDigitsFixture, GML_id_digits_avx512)(benchmark::State& state) {
+    if (!cpuSupports(IsaLevel::Avx512)) {
+        state.SkipWithError("AVX-512BW not supported on this CPU");
+        return;
+    }
+    run(state, idDigitsAvx512);
+}
+BENCHMARK_REGISTER_F(IdDigitsFixture, GML_id_digits_avx512);
+
+BENCHMARK_DEFINE_F(IdDigitsFixture, GML_id_digits_avx512_vbmi)(benchmark::State& state) {
+    if (!cpuSupports(IsaLevel::Avx512Vbmi)) {
+        state.SkipWithError("AVX-512VBMI not supported on this CPU");
+        return;
+    }
+    run(state, idDigitsAvx512Vbmi);
+}
+BENCHMARK_REGISTER_F(IdDigitsFixture, GML_id_digits_avx512_vbmi);
+#endif
@@ -0,0 +1,240 @@
+#pragma once
+#include "Digits.h"
+#include "FixedString.h"
+#include "GmlSerializer.h"
+#include "Simd.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Columnar (SoA) copy of a Sample_t batch. Sample_t is 272 bytes, 256 of
+// them the mostly-empty name, so the AoS layout drags dead name bytes through
+// the cache. Here each field is its own array and the names are packed
+// back to back in one string pool.
+struct SampleBatch {
+    std::vector<uint8_t> flags;
+    std::vector<int> ids;
+    std::vector<double> values;
+    std::vector<uint32_t> nameOffsets;  // size() + 1 entries into namePool
+    std::vector<char> namePool;
+
+    SampleBatch() = default;
+    explicit SampleBatch(const std::span<const Sample_t> samples) { assign(samples); }
+
+    void assign(const std::span<const Sample_t> samples) {
+        flags.resize(samples.size());
+        ids.resize(samples.size());
+        values.resize(samples.size());
+        nameOffsets.resize(samples.size() + 1);
+        namePool.clear();
+        nameOffsets[0] = 0;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const auto& s = samples[i];
+            flags[i] = s.flag;
+            ids[i] = s.id;
+            values[i] = s.value;
+            const size_t size = boundedStrlen(s.name);
+            namePool.insert(namePool.end(), s.name, s.name + size);
+            nameOffsets[i + 1] = static_cast<uint32_t>(namePool.size());
+        }
+    }
+
+    size_t size() const { return flags.size(); }
+
+    std::string_view name(const size_t i) const {
+        return { namePool.data() + nameOffsets[i], nameOffsets[i + 1] - nameOffsets[i] };
+    }
+};
+
+// Column kernels. Each one turns a run of a column into the per-record
+// pieces the interleave step copies out.
+
+// flags -> FLAG_FRAGMENTS indexes
+inline void flagIndexesScalar(uint8_t* indexes, const uint8_t* flags, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        indexes[i] = flags[i] != 0;
+    }
+}
+
+#if GML_X86
+inline void flagIndexesSse2(uint8_t* indexes, const uint8_t* flags, const size_t count) {
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indexes + i), _mm_min_epu8(v, one));
+    }
+    flagIndexesScalar(indexes + i, flags + i, count - i);
+}
+#endif
+
+// ids -> decimal digit slots
+inline void idDigitsScalar(DigitSlot* slots, const int* ids, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        toDigitsScalar(slots[i], ids[i]);
+    }
+}
+
+#if GML_X86
+inline void idDigitsSse2(DigitSlot* slots, const int* ids, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        toDigitsSse2(slots[i], ids[i]);
+    }
+}
+
+GML_TARGET(GML_AVX512) inline void idDigitsAvx512(DigitSlot* slots, const int* ids, const size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        toDigitsX16Avx512(slots + i, ids + i);
+    }
+    idDigitsSse2(slots + i, ids + i, count - i);
+}
+
+GML_TARGET(GML_AVX512_VBMI) inline void idDigitsAvx512Vbmi(DigitSlot* slots, const int* ids, const size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        toDigitsX16Avx512Vbmi(slots + i, ids + i);
+    }
+    idDigitsSse2(slots + i, ids + i, count - i);
+}
+#endif
+
+// Interleave step: writes records begin..begin + count from the batch and
+// the chunk's flag indexes and id slots
+using InterleaveKernel = char* (*)(char* dst, const SampleBatch& batch, size_t begin, size_t count,
+    const uint8_t* flagIndexes, const DigitSlot* idSlots);
+
+inline char* interleaveScalar(char* dst, const SampleBatch& batch, const size_t begin, const size_t count,
+    const uint8_t* flagIndexes, const DigitSlot* idSlots) {
+    for (size_t i = 0; i < count; ++i) {
+        dst = FLAG_FRAGMENTS.write(dst, flagIndexes[i]);
+        std::memcpy(dst, ID_LABEL.data(), ID_LABEL.size());
+        dst = idSlots[i].copyTo(dst + ID_LABEL.size());
+        std::memcpy(dst, VALUE_LABEL.data(), VALUE_LABEL.size());
+        dst = fmt::format_to(dst + VALUE_LABEL.size(), "{:.3f}", batch.values[begin + i]);
+        std::memcpy(dst, VALUE_UNITS.data(), VALUE_UNITS.size());
+        dst += VALUE_UNITS.size();
+        std::memcpy(dst, NAME_LABEL.data(), NAME_LABEL.size());
+        dst += NAME_LABEL.size();
+        const auto name = batch.name(begin + i);
+        std::memcpy(dst, name.data(), name.size());
+        dst += name.size();
+    }
+    return dst;
+}
+
+#if GML_X86
+// Units and name label are adjacent in every record, so they go out as one
+// fragment
+inline constexpr auto UNITS_NAME_LABEL = [] {
+    std::array<char, VALUE_UNITS.size() + NAME_LABEL.size()> text{};
+    std::copy(VALUE_UNITS.begin(), VALUE_UNITS.end(), text.begin());
+    std::copy(NAME_LABEL.begin(), NAME_LABEL.end(), text.begin() + VALUE_UNITS.size());
+    return text;
+}();
+
+static_assert(ID_LABEL.size() == 16, "the id fragment is the label in one 128-bit half, digits in the other");
+static_assert(MAX_FLAG_SIZE <= 32 && VALUE_LABEL.size() <= 32 && UNITS_NAME_LABEL.size() <= 32,
+    "fixed fragments are written with one 32-byte masked store");
+
+// Every fixed-layout fragment goes out with one masked store of its exact
+// length, and the id label and digits are joined in a register first, so
+// nothing is written past the record and no slot over-reads are needed
+GML_TARGET(GML_AVX512) inline char* interleaveAvx512(char* dst, const SampleBatch& batch, const size_t begin,
+    const size_t count, const uint8_t* flagIndexes, const DigitSlot* idSlots) {
+    const auto lowBits = [](const size_t n) { return n >= 64 ? ~0ull : (1ull << n) - 1; };
+    const auto mask32 = [&](const size_t n) { return static_cast<__mmask32>(lowBits(n)); };
+    const __m128i idLabel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ID_LABEL.data()));
+    const __m256i valueLabel = _mm256_maskz_loadu_epi8(mask32(VALUE_LABEL.size()), VALUE_LABEL.data());
+    const __m256i unitsNameLabel = _mm256_maskz_loadu_epi8(mask32(UNITS_NAME_LABEL.size()), UNITS_NAME_LABEL.data());
+    for (size_t i = 0; i < count; ++i) {
+        const auto flag = FLAG_FRAGMENTS[flagIndexes[i]];
+        _mm256_mask_storeu_epi8(dst, mask32(flag.size()), _mm256_maskz_loadu_epi8(mask32(flag.size()), flag.data()));
+        dst += flag.size();
+
+        const auto& id = idSlots[i];
+        const __m128i digits = _mm_maskz_loadu_epi8(static_cast<__mmask16>(lowBits(id.size)), id.text + id.offset);
+        _mm256_mask_storeu_epi8(dst, mask32(ID_LABEL.size() + id.size), _mm256_set_m128i(digits, idLabel));
+        dst += ID_LABEL.size() + id.size;
+
+        _mm256_mask_storeu_epi8(dst, mask32(VALUE_LABEL.size()), valueLabel);
+        dst = fmt::format_to(dst + VALUE_LABEL.size(), "{:.3f}", batch.values[begin + i]);
+        _mm256_mask_storeu_epi8(dst, mask32(UNITS_NAME_LABEL.size()), unitsNameLabel);
+        dst += UNITS_NAME_LABEL.size();
+
+        const auto name = batch.name(begin + i);
+        for (size_t pos = 0; pos < name.size(); pos += 64) {
+            const __mmask64 m = lowBits(name.size() - pos);
+            _mm512_mask_storeu_epi8(dst + pos, m, _mm512_maskz_loadu_epi8(m, name.data() + pos));
+        }
+        dst += name.size();
+    }
+    return dst;
+}
+#endif
+
+using FlagIndexesKernel = void (*)(uint8_t* indexes, const uint8_t* flags, size_t count);
+using IdDigitsKernel = void (*)(DigitSlot* slots, const int* ids, size_t count);
+
+// Resolved once, on first use, for the active ISA level
+inline FlagIndexesKernel flagIndexesKernel() {
+    static const FlagIndexesKernel kernel = selectKernel<FlagIndexesKernel>({
+#if GML_X86
+        { IsaLevel::Sse2, flagIndexesSse2 },
+#endif
+        { IsaLevel::Scalar, flagIndexesScalar },
+    });
+    return kernel;
+}
+
+inline IdDigitsKernel idDigitsKernel() {
+    static const IdDigitsKernel kernel = selectKernel<IdDigitsKernel>({
+#if GML_X86
+        { IsaLevel::Avx512Vbmi, idDigitsAvx512Vbmi },
+        { IsaLevel::Avx512, idDigitsAvx512 },
+        { IsaLevel::Sse2, idDigitsSse2 },
+#endif
+        { IsaLevel::Scalar, idDigitsScalar },
+    });
+    return kernel;
+}
+
+inline InterleaveKernel interleaveKernel() {
+    static const InterleaveKernel kernel = selectKernel<InterleaveKernel>({
+#if GML_X86
+        { IsaLevel::Avx512, interleaveAvx512 },
+#endif
+        { IsaLevel::Scalar, interleaveScalar },
+    });
+    return kernel;
+}
+
+// Serializes a SampleBatch with the same output as writeSample on each
+// record. Records are processed in chunks: the column kernels fill small
+// scratch arrays that stay in L1, then one pass interleaves the fragments.
+// dst needs 32 bytes of headroom past the output.
+class BatchSerializer {
+public:
+    static constexpr size_t CHUNK{ 256 };
+
+    char* write(char* dst, const SampleBatch& batch) {
+        for (size_t begin = 0; begin < batch.size(); begin += CHUNK) {
+            const size_t count = std::min(CHUNK, batch.size() - begin);
+            flagKernel(flagIndexes, batch.flags.data() + begin, count);
+            idKernel(idSlots, batch.ids.data() + begin, count);
+            dst = interleave(dst, batch, begin, count, flagIndexes, idSlots);
+        }
+        return dst;
+    }
+
+private:
+    const FlagIndexesKernel flagKernel{ flagIndexesKernel() };
+    const IdDigitsKernel idKernel{ idDigitsKernel() };
+    const InterleaveKernel interleave{ interleaveKernel() };
+    uint8_t flagIndexes[CHUNK]{};
+    DigitSlot idSlots[CHUNK + 1]{};  // Spare slot for DigitSlot::copyTo
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include "GmlSerializer.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Generates reproducible Sample_t records for the batch benchmarks.
+// Names are drawn from a small set of realistic platform names.
+inline std::vector<Sample_t> makeSamples(const size_t count, const unsigned seed = 42) {
+    static constexpr const char* NAMES[] = {
+        "Sample Name",
+        "Alpha Battery",
+        "Bravo Launcher 7",
+        "Charlie Forward Observation Post",
+        "Delta",
+        "Echo Mobile Radar Section North",
+        "Foxtrot",
+        "Golf Relay Station"
+    };
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> flagDist(0, 1);
+    std::uniform_int_distribution<int> idDist(1, 999'999);
+    std::uniform_real_distribution<double> valueDist(0.0, 50'000.0);
+    std::uniform_int_distribution<size_t> nameDist(0, std::size(NAMES) - 1);
+
+    std::vector<Sample_t> samples(count);
+    for (auto& s : samples) {
+        s.flag = static_cast<uint8_t>(flagDist(rng));
+        s.id = idDist(rng);
+        s.value = valueDist(rng);
+        const char* name = NAMES[nameDist(rng)];
+        std::memcpy(s.name, name, std::strlen(name) + 1);
+    }
+    return samples;
+}
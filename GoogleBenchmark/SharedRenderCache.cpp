@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "SampleData.h"
+#include "SharedRenderCache.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+static constexpr size_t SHARED_CAPACITY{ 4'096 };
+static constexpr size_t SHARED_HOT_RECORDS{ 2'048 };
+static constexpr size_t SHARED_COLD_RECORDS{ 65'536 };
+static constexpr size_t SHARED_STREAM{ 65'536 };
+static constexpr double SHARED_RESEND{ 0.98 };
+
+// Records and feed shared by every benchmark thread: 98% of the feed re-sends
+// the hot set, which all threads see, the rest are cold one-off records.
+struct SharedFeed {
+    std::vector<Sample_t> records;
+    std::vector<uint32_t> stream;
+
+    SharedFeed() : records(makeSamples(SHARED_HOT_RECORDS + SHARED_COLD_RECORDS)) {
+        for (size_t i = 0; i < records.size(); ++i) {
+            records[i].id = static_cast<int>(i);
+        }
+        std::mt19937 rng(42);
+        std::bernoulli_distribution resend(SHARED_RESEND);
+        std::uniform_int_distribution<uint32_t> hot(0, SHARED_HOT_RECORDS - 1);
+        std::uniform_int_distribution<uint32_t> cold(SHARED_HOT_RECORDS, SHARED_HOT_RECORDS + SHARED_COLD_RECORDS - 1);
+        stream.resize(SHARED_STREAM);
+        for (auto& r : stream) {
+            r = resend(rng) ? hot(rng) : cold(rng);
+        }
+    }
+};
+
+static const SharedFeed& sharedFeed() {
+    static const SharedFeed feed;
+    return feed;
+}
+
+// Thread 0 creates the shared cache before the timing loop and destroys it
+// after; the benchmark library's start/stop barriers order the other threads.
+template <typename Cache>
+static void runSharedCache(benchmark::State& state, std::unique_ptr<Cache>& cache) {
+    const auto& feed = sharedFeed();
+    if (state.thread_index() == 0) {
+        cache = std::make_unique<Cache>(SHARED_CAPACITY);
+    }
+    char out[MAX_SAMPLE_SIZE + GML_HEADROOM];
+    size_t idx = static_cast<size_t>(state.thread_index()) * 7'919;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = cache->write(out, feed.records[feed.stream[idx++ % feed.stream.size()]]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        cache.reset();
+    }
+}
+
+static void GML_shared_cache_none(benchmark::State& state) {
+    const auto& feed = sharedFeed();
+    char out[MAX_SAMPLE_SIZE + GML_HEADROOM];
+    size_t idx = static_cast<size_t>(state.thread_index()) * 7'919;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        char* pEnd = writeSample(out, feed.records[feed.stream[idx++ % feed.stream.size()]]);
+        benchmark::DoNotOptimize(pEnd);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(GML_shared_cache_none)->ThreadRange(1, 64)->UseRealTime();
+
+static void GML_shared_cache_shared_mutex(benchmark::State& state) {
+    static std::unique_ptr<LockedRenderCache> cache;
+    runSharedCache(state, cache);
+}
+BENCHMARK(GML_shared_cache_shared_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void GML_shared_cache_lock_free(benchmark::State& state) {
+    static std::unique_ptr<SharedRenderCache> cache;
+    runSharedCache(state, cache);
+}
+BENCHMARK(GML_shared_cache_lock_free)->ThreadRange(1, 64)->UseRealTime();
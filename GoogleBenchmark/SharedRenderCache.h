@@ -0,0 +1,171 @@
+#pragma once
+#include "EpochDomain.h"
+#include "FixedString.h"
+#include "GmlSerializer.h"
+#include "RenderCache.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Immutable rendered record: header, then the GML text, then the key's name
+// bytes, in one allocation. Never modified after it is published.
+struct RenderedFragment {
+    uint64_t hash;
+    int id;
+    double value;
+    uint8_t flag;
+    uint16_t nameSize;
+    uint16_t size;
+
+    const char* text() const { return reinterpret_cast<const char*>(this + 1); }
+    const char* name() const { return text() + size; }
+
+    bool matches(const Sample_t& sample, const size_t sampleNameSize) const {
+        return flag == sample.flag && id == sample.id &&
+            std::memcmp(&value, &sample.value, sizeof(value)) == 0 &&
+            nameSize == sampleNameSize && std::memcmp(name(), sample.name, sampleNameSize) == 0;
+    }
+
+    static RenderedFragment* make(const Sample_t& sample, const size_t nameSize, const uint64_t hash) {
+        char buf[MAX_SAMPLE_SIZE + GML_HEADROOM];
+        const auto size = static_cast<size_t>(writeSampleFragments(buf, sample) - buf);
+        void* raw = ::operator new(sizeof(RenderedFragment) + size + nameSize);
+        auto* f = new (raw) RenderedFragment{ hash, sample.id, sample.value, sample.flag,
+            static_cast<uint16_t>(nameSize), static_cast<uint16_t>(size) };
+        char* text = reinterpret_cast<char*>(f + 1);
+        std::memcpy(text, buf, size);
+        std::memcpy(text + size, sample.name, nameSize);
+        return f;
+    }
+
+    static void destroy(void* p) { ::operator delete(p); }
+};
+
+// Concurrent read-mostly cache of rendered records shared by all formatter
+// threads. Open addressing over atomic slot pointers: a lookup probes a short
+// window with atomic loads and copies the text out under an epoch pin, with
+// no locks and no shared writes. A miss renders outside the pin, then takes
+// an empty slot in the window with a CAS or replaces a hash-chosen victim;
+// replaced fragments go to the EpochDomain and are freed once no reader can
+// still see them.
+class SharedRenderCache {
+public:
+    static constexpr size_t PROBE{ 4 };
+
+    explicit SharedRenderCache(const size_t capacity)
+        : slots(std::bit_ceil(capacity)), mask(slots.size() - 1) {}
+
+    // Only destroy once no thread is using the cache
+    ~SharedRenderCache() {
+        for (auto& slot : slots) {
+            RenderedFragment::destroy(slot.load(std::memory_order_relaxed));
+        }
+    }
+
+    SharedRenderCache(const SharedRenderCache&) = delete;
+    SharedRenderCache& operator=(const SharedRenderCache&) = delete;
+
+    // Writes the GML for sample at dst and returns the new end
+    char* write(char* dst, const Sample_t& sample) {
+        const size_t nameSize = boundedStrlen(sample.name);
+        const uint64_t hash = hashSample(sample, nameSize);
+        {
+            const auto guard = epochs.pin();
+            for (size_t i = 0; i < PROBE; ++i) {
+                const RenderedFragment* f = slots[(hash + i) & mask].load();
+                if (f && f->hash == hash && f->matches(sample, nameSize)) {
+                    std::memcpy(dst, f->text(), f->size);
+                    return dst + f->size;
+                }
+            }
+        }
+        RenderedFragment* fresh = RenderedFragment::make(sample, nameSize, hash);
+        std::memcpy(dst, fresh->text(), fresh->size);
+        dst += fresh->size;
+        publish(fresh, hash);
+        return dst;
+    }
+
+private:
+    void publish(RenderedFragment* fresh, const uint64_t hash) {
+        for (size_t i = 0; i < PROBE; ++i) {
+            RenderedFragment* expected = nullptr;
+            if (slots[(hash + i) & mask].compare_exchange_strong(expected, fresh)) {
+                return;
+            }
+        }
+        auto& victim = slots[(hash + ((hash >> 32) % PROBE)) & mask];
+        if (RenderedFragment* old = victim.exchange(fresh)) {
+            epochs.retire(old, RenderedFragment::destroy);
+        }
+    }
+
+    EpochDomain& epochs{ EpochDomain::instance() };
+    std::vector<std::atomic<RenderedFragment*>> slots;
+    size_t mask;
+};
+
+// Baseline: std::unordered_map under a std::shared_mutex, bounded by evicting
+// an arbitrary entry when full.
+class LockedRenderCache {
+public:
+    explicit LockedRenderCache(const size_t maxEntries) : capacity(maxEntries) {
+        map.reserve(maxEntries);
+    }
+
+    char* write(char* dst, const Sample_t& sample) {
+        const size_t nameSize = boundedStrlen(sample.name);
+        const uint64_t hash = hashSample(sample, nameSize);
+        {
+            std::shared_lock lock(mutex);
+            if (const auto it = map.find(hash); it != map.end() && it->second.key.matches(sample, nameSize)) {
+                std::memcpy(dst, it->second.text.data(), it->second.text.size());
+                return dst + it->second.text.size();
+            }
+        }
+        char* pEnd = writeSampleFragments(dst, sample);
+        Entry entry{ {}, std::string(dst, pEnd) };
+        entry.key.assign(sample, nameSize);
+        std::unique_lock lock(mutex);
+        if (map.size() >= capacity) {
+            map.erase(map.begin());
+        }
+        map.insert_or_assign(hash, std::move(entry));
+        return pEnd;
+    }
+
+private:
+    struct Key {
+        int id{ 0 };
+        double value{ 0 };
+        uint8_t flag{ 0 };
+        std::string name;
+
+        void assign(const Sample_t& sample, const size_t nameSize) {
+            id = sample.id;
+            value = sample.value;
+            flag = sample.flag;
+            name.assign(sample.name, nameSize);
+        }
+        bool matches(const Sample_t& sample, const size_t nameSize) const {
+            return flag == sample.flag && id == sample.id &&
+                std::memcmp(&value, &sample.value, sizeof(value)) == 0 &&
+                name.size() == nameSize && std::memcmp(name.data(), sample.name, nameSize) == 0;
+        }
+    };
+    struct Entry {
+        Key key;
+        std::string text;
+    };
+
+    size_t capacity;
+    std::shared_mutex mutex;
+    std::unordered_map<uint64_t, Entry> map;
+};
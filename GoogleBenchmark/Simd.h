@@ -0,0 +1,151 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+// x86 SIMD support for the formatting kernels. MSVC accepts any ISA's
+// intrinsics in any function; GCC and Clang need a per-function target.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GML_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define GML_X86 0
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define GML_X64 1
+#else
+#define GML_X64 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define GML_TARGET(isa)
+#else
+#define GML_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// GML_TARGET strings for the two AVX-512 levels below
+#define GML_AVX512 "avx512f,avx512bw,avx512vl,avx512dq"
+#define GML_AVX512_VBMI GML_AVX512 ",avx512vbmi"
+
+// Instruction set levels the kernels are written for, in increasing order.
+// Each level implies the ones below it. Avx512 is F+BW+VL+DQ (Skylake-X);
+// Avx512Vbmi adds VBMI (Ice Lake and later).
+enum class IsaLevel { Scalar, Sse2, Sse41, Avx2, Avx512, Avx512Vbmi };
+
+inline constexpr std::string_view ISA_LEVEL_NAMES[] = { "scalar", "sse2", "sse4.1", "avx2", "avx512", "avx512vbmi" };
+
+inline std::string_view isaLevelName(const IsaLevel level) {
+    return ISA_LEVEL_NAMES[static_cast<int>(level)];
+}
+
+inline bool parseIsaLevel(const std::string_view name, IsaLevel& level) {
+    for (size_t i = 0; i < std::size(ISA_LEVEL_NAMES); ++i) {
+        if (name == ISA_LEVEL_NAMES[i]) {
+            level = static_cast<IsaLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+#if GML_X86
+inline void cpuid(int (&regs)[4], const int leaf, const int subleaf) {
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, subleaf);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Highest level the CPU and OS support. AVX levels also need the OS to save
+// YMM (XCR0 bits 1-2) and ZMM/opmask state (XCR0 bits 5-7).
+GML_TARGET("xsave") inline IsaLevel queryIsaLevel() {
+    int regs[4]{};
+    cpuid(regs, 1, 0);
+    const int ecx1 = regs[2];
+    const int edx1 = regs[3];
+    if ((edx1 & (1 << 26)) == 0) {
+        return IsaLevel::Scalar;
+    }
+    if ((ecx1 & (1 << 19)) == 0) {
+        return IsaLevel::Sse2;
+    }
+    const bool osxsave = (ecx1 & (1 << 27)) != 0;
+    const bool avx = (ecx1 & (1 << 28)) != 0;
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    cpuid(regs, 0, 0);
+    const bool hasLeaf7 = regs[0] >= 7;
+    if (!avx || (xcr0 & 0x6) != 0x6 || !hasLeaf7) {
+        return IsaLevel::Sse41;
+    }
+    cpuid(regs, 7, 0);
+    const int ebx7 = regs[1];
+    const int ecx7 = regs[2];
+    if ((ebx7 & (1 << 5)) == 0) {
+        return IsaLevel::Sse41;
+    }
+    constexpr int AVX512_F = 1 << 16;
+    constexpr int AVX512_DQ = 1 << 17;
+    constexpr int AVX512_BW = 1 << 30;
+    constexpr int AVX512_VL = 1 << 31;
+    constexpr int AVX512 = AVX512_F | AVX512_DQ | AVX512_BW | AVX512_VL;
+    if ((ebx7 & AVX512) != AVX512 || (xcr0 & 0xe6) != 0xe6) {
+        return IsaLevel::Avx2;
+    }
+    return (ecx7 & (1 << 1)) != 0 ? IsaLevel::Avx512Vbmi : IsaLevel::Avx512;
+}
+#else
+inline IsaLevel queryIsaLevel() { return IsaLevel::Scalar; }
+#endif
+
+// cpuid runs once per process
+inline IsaLevel cpuIsaLevel() {
+    static const IsaLevel level = queryIsaLevel();
+    return level;
+}
+
+inline bool cpuSupports(const IsaLevel level) {
+    return cpuIsaLevel() >= level;
+}
+
+inline bool cpuHasAvx2() {
+    return cpuSupports(IsaLevel::Avx2);
+}
+
+// Cap on the level the dispatched routines may pick, so each level can be
+// benchmarked on one machine (--gml_isa). Set it before the first dispatched
+// call: every routine resolves its kernel once and keeps it.
+inline IsaLevel& isaLevelLimit() {
+    static IsaLevel limit = IsaLevel::Avx512Vbmi;
+    return limit;
+}
+
+inline IsaLevel activeIsaLevel() {
+    return std::min(cpuIsaLevel(), isaLevelLimit());
+}
+
+// One implementation of a dispatched routine and the level it needs
+template <class Fn>
+struct IsaKernel {
+    IsaLevel level;
+    Fn fn;
+};
+
+// Picks the first kernel the active level allows; list them widest first and
+// end with one that needs nothing.
+template <class Fn, size_t N>
+Fn selectKernel(const IsaKernel<Fn> (&kernels)[N]) {
+    const IsaLevel active = activeIsaLevel();
+    for (const auto& kernel : kernels) {
+        if (kernel.level <= active) {
+            return kernel.fn;
+        }
+    }
+    return kernels[N - 1].fn;
+}
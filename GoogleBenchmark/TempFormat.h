@@ -0,0 +1,86 @@
+#pragma once
+#include "fmt/format.h"
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// fmt::format without the std::string, for call sites that only need the
+// text briefly (strcat_s it somewhere, compare it, log it). The text goes
+// into a thread-local fmt::memory_buffer that is reused call after call, so
+// once the buffer has grown to the largest result nothing allocates.
+//
+// The returned view is null-terminated (data() works as a C string) and stays
+// valid until the next formatTemp call on the same thread.
+inline fmt::memory_buffer& tempFormatBuffer() {
+    thread_local fmt::memory_buffer buffer;
+    return buffer;
+}
+
+inline std::string_view vformatTemp(const fmt::string_view format, const fmt::format_args args) {
+    auto& buffer = tempFormatBuffer();
+    buffer.clear();
+    fmt::vformat_to(fmt::appender(buffer), format, args);
+    buffer.push_back('\0');
+    return { buffer.data(), buffer.size() - 1 };
+}
+
+template <typename... T>
+std::string_view formatTemp(const fmt::format_string<T...> format, T&&... args) {
+    return vformatTemp(format.get(), fmt::make_format_args(args...));
+}
+
+// Builds one text from several pieces in a buffer borrowed from a
+// thread-local pool, and hands the buffer back on destruction. Each live
+// builder has its own buffer, so builders nest and formatTemp can be used
+// while one is open. view() and c_str() are valid until the next append or
+// the end of the scope.
+class TempFormatBuilder {
+public:
+    TempFormatBuilder() : buffer(acquire()) { buffer->clear(); }
+    ~TempFormatBuilder() { pool().push_back(std::move(buffer)); }
+    TempFormatBuilder(const TempFormatBuilder&) = delete;
+    TempFormatBuilder& operator=(const TempFormatBuilder&) = delete;
+
+    template <typename... T>
+    TempFormatBuilder& append(const fmt::format_string<T...> format, T&&... args) {
+        fmt::vformat_to(fmt::appender(*buffer), format.get(), fmt::make_format_args(args...));
+        return *this;
+    }
+
+    TempFormatBuilder& append(const std::string_view text) {
+        buffer->append(text);
+        return *this;
+    }
+
+    std::string_view view() const { return { buffer->data(), buffer->size() }; }
+
+    // Writes a terminator just past the text without making it part of it
+    const char* c_str() {
+        buffer->push_back('\0');
+        buffer->resize(buffer->size() - 1);
+        return buffer->data();
+    }
+
+    void clear() { buffer->clear(); }
+
+private:
+    using Pool = std::vector<std::unique_ptr<fmt::memory_buffer>>;
+
+    static Pool& pool() {
+        thread_local Pool buffers;
+        return buffers;
+    }
+
+    static std::unique_ptr<fmt::memory_buffer> acquire() {
+        auto& buffers = pool();
+        if (buffers.empty()) {
+            return std::make_unique<fmt::memory_buffer>();
+        }
+        auto buffer = std::move(buffers.back());
+        buffers.pop_back();
+        return buffer;
+    }
+
+    std::unique_ptr<fmt::memory_buffer> buffer;
+};
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "FmtStages.h"
+#include "Timestamp.h"
+#include "fmt/chrono.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+using Microseconds = std::chrono::sys_time<std::chrono::microseconds>;
+
+// The timestamp field of a GML record, in microseconds. state.range(0)
+// picks the times: 0 monotonic, a record every 250 us as a live feed
+// produces them (a new second every 4000 records), 1 random within a
+// year, as when replaying merged logs (a new second on nearly every record).
+// The feed spans four seconds, so the monotonic case crosses a second
+// boundary at that rate, including when the index wraps to the start.
+class TimestampFixture : public benchmark::Fixture {
+public:
+    std::vector<Microseconds> times;
+    char out[MAX_TIMESTAMP_SIZE]{};
+
+    void SetUp(const ::benchmark::State& state) override {
+        // 2024-06-01T00:00:00Z
+        const Microseconds start{ std::chrono::seconds(1'717'200'000) };
+        times.resize(16'000);
+        if (state.range(0) == 0) {
+            for (size_t i = 0; i < times.size(); ++i) {
+                times[i] = start + std::chrono::microseconds(250 * static_cast<int64_t>(i));
+            }
+        } else {
+            std::mt19937_64 rng(42);
+            std::uniform_int_distribution<int64_t> offset(0, 365LL * 86'400 * 1'000'000);
+            for (auto& t : times) {
+                t = start + std::chrono::microseconds(offset(rng));
+            }
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /*state*/) override {
+        times.clear();
+    }
+};
+
+static void timeOrderArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("random")->Arg(0)->Arg(1);
+}
+
+// fmt/chrono: std::tm and tm_writer on every call
+BENCHMARK_DEFINE_F(TimestampFixture, GML_timestamp_fmt_chrono)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto t = times[idx++ % times.size()];
+        char* end = fmt::format_to(out, ";$Timestamp:$ {:%Y-%m-%dT%H:%M:%S}", t);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(TimestampFixture, GML_timestamp_fmt_chrono)->Apply(timeOrderArgs);
+
+// civilFromDays on every call, no cache
+BENCHMARK_DEFINE_F(TimestampFixture, GML_timestamp_civil)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto t = times[idx++ % times.size()];
+        std::memcpy(out, TIMESTAMP_LABEL.data(), TIMESTAMP_LABEL.size());
+        char* end = writeTimestamp(out + TIMESTAMP_LABEL.size(), t);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(TimestampFixture, GML_timestamp_civil)->Apply(timeOrderArgs);
+
+BENCHMARK_DEFINE_F(TimestampFixture, GML_timestamp_cached)(benchmark::State& state) {
+    size_t idx = 0;
+    for (auto _ : state) {
+        const auto t = times[idx++ % times.size()];
+        char* end = writeTimestampField(out, t);
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(TimestampFixture, GML_timestamp_cached)->Apply(timeOrderArgs);
+
+// The cached writer behind a format string, as record templates use it
+BENCHMARK_DEFINE_F(TimestampFixture, GML_timestamp_fmt_cached)(benchmark::State& state) {
+    size_t idx = 0;
+    const FmtStageCounters stages(state);
+    for (auto _ : state) {
+        const auto t = times[idx++ % times.size()];
+        char* end = fmt::format_to(out, ";$Timestamp:$ {}", GmlTimestamp<std::chrono::microseconds>{ t });
+        benchmark::DoNotOptimize(end);
+    }
+}
+BENCHMARK_REGISTER_F(TimestampFixture, GML_timestamp_fmt_cached)->Apply(timeOrderArgs);
@@ -0,0 +1,174 @@
+#pragma once
+#include "Digits.h"
+#include "fmt/format.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ratio>
+#include <string_view>
+
+// GML timestamp field, "YYYY-MM-DDTHH:MM:SS.ffffff" in UTC: the same text as
+// fmt "{:%Y-%m-%dT%H:%M:%S}" for a sys_time, with as many fraction digits as
+// the duration resolves (none for seconds, 3 for milliseconds, 6 for
+// microseconds, 9 for nanoseconds). fmt/chrono goes through std::tm and
+// tm_writer on every call; here the date comes from civilFromDays and the
+// 19-character prefix is rendered once per second and cached, so a stream
+// of records within the same second only writes the fraction digits.
+// Years 0000 to 9999.
+
+static constexpr std::string_view TIMESTAMP_LABEL{ ";$Timestamp:$ " };
+static constexpr size_t TIMESTAMP_PREFIX_SIZE{ 19 };
+static constexpr size_t MAX_TIMESTAMP_SIZE{ TIMESTAMP_LABEL.size() + TIMESTAMP_PREFIX_SIZE + 10 };
+
+struct CivilDate {
+    int64_t year;
+    unsigned month;  // 1 to 12
+    unsigned day;    // 1 to 31
+};
+
+// Proleptic Gregorian date of a day count since 1970-01-01 (H. Hinnant's
+// civil_from_days): 400-year eras, with years starting in March so the leap
+// day falls last
+constexpr CivilDate civilFromDays(int64_t days) {
+    days += 719'468;
+    const int64_t era = (days >= 0 ? days : days - 146'096) / 146'097;
+    const auto dayOfEra = static_cast<unsigned>(days - era * 146'097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1'460 + dayOfEra / 36'524 - dayOfEra / 146'096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned monthFromMarch = (5 * dayOfYear + 2) / 153;
+    const unsigned day = dayOfYear - (153 * monthFromMarch + 2) / 5 + 1;
+    const unsigned month = monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9;
+    return { static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0), month, day };
+}
+
+// Writes "YYYY-MM-DDTHH:MM:SS" for whole seconds since the epoch
+inline char* writeTimestampPrefix(char* dst, const int64_t seconds) {
+    const int64_t days = (seconds >= 0 ? seconds : seconds - 86'399) / 86'400;
+    const auto secondOfDay = static_cast<unsigned>(seconds - days * 86'400);
+    const CivilDate date = civilFromDays(days);
+    const auto year = static_cast<unsigned>(date.year);
+    const auto pair = [](char* p, const unsigned n) { std::memcpy(p, DIGIT_PAIRS + n * 2, 2); };
+    pair(dst, year / 100);
+    pair(dst + 2, year % 100);
+    dst[4] = '-';
+    pair(dst + 5, date.month);
+    dst[7] = '-';
+    pair(dst + 8, date.day);
+    dst[10] = 'T';
+    pair(dst + 11, secondOfDay / 3'600);
+    dst[13] = ':';
+    pair(dst + 14, secondOfDay / 60 % 60);
+    dst[16] = ':';
+    pair(dst + 17, secondOfDay % 60);
+    return dst + TIMESTAMP_PREFIX_SIZE;
+}
+
+// Fraction digits for a duration, as fmt/chrono prints them
+template <typename Duration>
+constexpr int timestampFractionDigits() {
+    using Period = typename Duration::period;
+    static_assert(Period::num == 1 && Period::den <= 1'000'000'000, "sub-second periods down to nanoseconds");
+    int digits = 0;
+    for (intmax_t den = Period::den; den > 1; den /= 10) {
+        ++digits;
+    }
+    return digits;
+}
+
+// The time split into whole seconds since the epoch and the ticks past
+// that second, rounding towards the past as fmt does
+template <typename Duration>
+struct TimestampParts {
+    int64_t seconds;
+    int64_t ticks;
+
+    explicit TimestampParts(const std::chrono::sys_time<Duration> time) {
+        constexpr int64_t TICKS_PER_SECOND{ Duration::period::den };
+        const int64_t count = time.time_since_epoch().count();
+        seconds = (count >= 0 ? count : count - (TICKS_PER_SECOND - 1)) / TICKS_PER_SECOND;
+        ticks = count - seconds * TICKS_PER_SECOND;
+    }
+};
+
+template <int Digits>
+inline char* writeTimestampFraction(char* dst, uint32_t ticks) {
+    if constexpr (Digits > 0) {
+        *dst = '.';
+        char* p = dst + 1 + Digits;
+        for (int i = 0; i + 1 < Digits; i += 2) {
+            p -= 2;
+            std::memcpy(p, DIGIT_PAIRS + (ticks % 100) * 2, 2);
+            ticks /= 100;
+        }
+        if constexpr (Digits % 2 != 0) {
+            *--p = static_cast<char>('0' + ticks);
+        }
+        return dst + 1 + Digits;
+    } else {
+        return dst;
+    }
+}
+
+// Uncached: the prefix is rendered on every call
+template <typename Duration>
+inline char* writeTimestamp(char* dst, const std::chrono::sys_time<Duration> time) {
+    const TimestampParts<Duration> parts(time);
+    dst = writeTimestampPrefix(dst, parts.seconds);
+    return writeTimestampFraction<timestampFractionDigits<Duration>()>(dst, static_cast<uint32_t>(parts.ticks));
+}
+
+// The prefix of the last second written. One per thread (see
+// writeTimestampCached) so the cache needs no synchronization.
+class TimestampPrefixCache {
+public:
+    template <typename Duration>
+    char* write(char* dst, const std::chrono::sys_time<Duration> time) {
+        const TimestampParts<Duration> parts(time);
+        if (parts.seconds != second) {
+            writeTimestampPrefix(prefix, parts.seconds);
+            second = parts.seconds;
+        }
+        std::memcpy(dst, prefix, TIMESTAMP_PREFIX_SIZE);
+        return writeTimestampFraction<timestampFractionDigits<Duration>()>(
+            dst + TIMESTAMP_PREFIX_SIZE, static_cast<uint32_t>(parts.ticks));
+    }
+
+private:
+    int64_t second{ INT64_MIN };
+    char prefix[TIMESTAMP_PREFIX_SIZE]{};
+};
+
+inline TimestampPrefixCache& threadTimestampCache() {
+    thread_local TimestampPrefixCache cache;
+    return cache;
+}
+
+template <typename Duration>
+inline char* writeTimestampCached(char* dst, const std::chrono::sys_time<Duration> time) {
+    return threadTimestampCache().write(dst, time);
+}
+
+// The whole field, label included
+template <typename Duration>
+inline char* writeTimestampField(char* dst, const std::chrono::sys_time<Duration> time) {
+    std::memcpy(dst, TIMESTAMP_LABEL.data(), TIMESTAMP_LABEL.size());
+    return writeTimestampCached(dst + TIMESTAMP_LABEL.size(), time);
+}
+
+// Formats through the calling thread's prefix cache:
+// fmt::format_to(out, ";$Timestamp:$ {}", GmlTimestamp{ time })
+template <typename Duration>
+struct GmlTimestamp {
+    std::chrono::sys_time<Duration> time;
+};
+
+template <typename Duration>
+struct fmt::formatter<GmlTimestamp<Duration>> {
+    constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+
+    auto format(const GmlTimestamp<Duration>& t, fmt::format_context& ctx) const {
+        char text[TIMESTAMP_PREFIX_SIZE + 10];
+        const char* end = writeTimestampCached(text, t.time);
+        return fmt::detail::copy<char>(static_cast<const char*>(text), end, ctx.out());
+    }
+};
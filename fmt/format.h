@@ -73,6 +73,40 @@
 #  endif
 #endif  // FMT_MODULE
 
+// SIMD for the ASCII scan in string width computation (ascii_prefix_size).
+#if defined(__AVX2__)
+#  define FMT_USE_AVX2 1
+#else
+#  define FMT_USE_AVX2 0
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define FMT_USE_SSE2 1
+#else
+#  define FMT_USE_SSE2 0
+#endif
+#if !defined(FMT_MODULE) && FMT_USE_AVX2
+#  include <immintrin.h>  // _mm256_movemask_epi8
+#elif !defined(FMT_MODULE) && FMT_USE_SSE2
+#  include <emmintrin.h>  // _mm_movemask_epi8
+#endif
+
+// Stage instrumentation: FMT_INSTRUMENT=1 adds cycle counter probes that
+// attribute formatting time to parsing, argument dispatch and writing (see
+// detail::stage_probe). Off by default. The probes are in format.h and
+// format-inl.h, so enable it with FMT_HEADER_ONLY or in the library build too.
+#ifndef FMT_INSTRUMENT
+#  define FMT_INSTRUMENT 0
+#endif
+#if FMT_INSTRUMENT && !defined(FMT_MODULE)
+#  if (defined(__GNUC__) || defined(__clang__)) && \
+      (defined(__x86_64__) || defined(__i386__))
+#    include <x86intrin.h>  // __rdtsc
+#  elif !FMT_MSC_VERSION || !(defined(_M_X64) || defined(_M_IX86))
+#    include <chrono>
+#  endif
+#endif
+
 #if defined(FMT_USE_NONTYPE_TEMPLATE_ARGS)
 // Use the provided definition.
 #elif defined(__NVCOMPILER)
@@ -153,6 +187,16 @@
 #  define FMT_CONSTEXPR_STRING
 #endif
 
+// Detect std::basic_string::resize_and_overwrite (C++23).
+#ifdef FMT_USE_RESIZE_AND_OVERWRITE
+// Use the provided definition.
+#elif defined(__cpp_lib_string_resize_and_overwrite) && \
+    __cpp_lib_string_resize_and_overwrite >= 202110L
+#  define FMT_USE_RESIZE_AND_OVERWRITE 1
+#else
+#  define FMT_USE_RESIZE_AND_OVERWRITE 0
+#endif
+
 // GCC 4.9 doesn't support qualified names in specializations.
 namespace std {
 template <typename T> struct iterator_traits<fmt::basic_appender<T>> {
@@ -685,6 +729,33 @@ FMT_CONSTEXPR inline auto display_width_of(uint32_t cp) noexcept -> size_t {
             (cp >= 0x1f900 && cp <= 0x1f9ff))));
 }
 
+// Returns the size of the pure-ASCII prefix of [begin, begin + n). Every
+// ASCII byte is a code point of display width 1, so that prefix needs no
+// decoding. Checks 32 bytes at a time where SIMD is available, 8 otherwise.
+inline auto ascii_prefix_size(const char* begin, size_t n) -> size_t {
+  size_t i = 0;
+#if FMT_USE_AVX2
+  for (; i + 32 <= n; i += 32) {
+    auto block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i));
+    if (_mm256_movemask_epi8(block) != 0) break;
+  }
+#elif FMT_USE_SSE2
+  for (; i + 32 <= n; i += 32) {
+    auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i));
+    auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i + 16));
+    if (_mm_movemask_epi8(_mm_or_si128(lo, hi)) != 0) break;
+  }
+#endif
+  for (; i + 8 <= n; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, begin + i, sizeof(word));
+    if ((word & 0x8080808080808080ull) != 0) break;
+  }
+  while (i < n && static_cast<unsigned char>(begin[i]) < 0x80) ++i;
+  return i;
+}
+
 template <typename T> struct is_integral : std::is_integral<T> {};
 template <> struct is_integral<int128_opt> : std::true_type {};
 template <> struct is_integral<uint128_t> : std::true_type {};
@@ -759,6 +830,129 @@ template <typename T> struct allocator : private std::decay<void> {
   }
 };
 
+// Growth policy hook for basic_memory_buffer: an allocator with a member
+// `size_t grow_capacity(size_t old_capacity, size_t size) const` chooses the
+// next capacity; all others grow by 1.5x.
+template <typename Alloc, typename = void>
+struct has_grow_capacity : std::false_type {};
+template <typename Alloc>
+struct has_grow_capacity<
+    Alloc, void_t<decltype(std::declval<const Alloc&>().grow_capacity(
+               size_t(), size_t()))>> : std::true_type {};
+
+template <typename Alloc, FMT_ENABLE_IF(has_grow_capacity<Alloc>::value)>
+FMT_CONSTEXPR auto grown_capacity(const Alloc& alloc, size_t old_capacity,
+                                  size_t size) -> size_t {
+  return alloc.grow_capacity(old_capacity, size);
+}
+template <typename Alloc, FMT_ENABLE_IF(!has_grow_capacity<Alloc>::value)>
+FMT_CONSTEXPR auto grown_capacity(const Alloc&, size_t old_capacity, size_t)
+    -> size_t {
+  return old_capacity + old_capacity / 2;
+}
+
+// A buffer over the storage of a std::string, so the output is written in
+// place instead of being copied out of a memory_buffer. While formatting the
+// string's size follows the buffer's capacity and the destructor trims it to
+// the formatted size. Growth uses resize_and_overwrite where available, which
+// skips the zero-fill that resize does.
+class string_buffer : public buffer<char> {
+ private:
+  std::string& str_;
+
+  static auto expose(std::string& s, size_t n) -> char* {
+#if FMT_USE_RESIZE_AND_OVERWRITE
+    s.resize_and_overwrite(n, [](char*, size_t count) { return count; });
+#else
+    s.resize(n);
+#endif
+    return &s[0];
+  }
+
+  static void grow(buffer<char>& buf, size_t capacity) {
+    auto& self = static_cast<string_buffer&>(buf);
+    size_t new_capacity = max_of(capacity, buf.capacity() * 2);
+    self.set(expose(self.str_, new_capacity), new_capacity);
+  }
+
+ public:
+  // Starts with whatever capacity the string already has, so short output
+  // into an empty string stays in the small-string storage.
+  explicit string_buffer(std::string& s)
+      : buffer<char>(grow, s.size()), str_(s) {
+    set(expose(s, s.capacity()), s.capacity());
+  }
+  ~string_buffer() { expose(str_, size()); }
+  string_buffer(const string_buffer&) = delete;
+  void operator=(const string_buffer&) = delete;
+};
+
+#if FMT_INSTRUMENT
+enum class stage { parse, dispatch, write };
+enum { num_stages = 3 };
+
+// Cycles and probe entries per stage, accumulated by the calling thread.
+struct stage_counters {
+  unsigned long long cycles[num_stages] = {};
+  unsigned long long calls[num_stages] = {};
+};
+
+inline auto thread_stage_counters() -> stage_counters& {
+  static thread_local stage_counters counters;
+  return counters;
+}
+
+inline auto read_cycle_counter() -> unsigned long long {
+#  if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+      defined(_M_IX86)
+  return __rdtsc();
+#  else
+  return static_cast<unsigned long long>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#  endif
+}
+
+// Charges the cycles spent in its scope to a stage. Probes nest, and each one
+// counts only its own time: a write inside a dispatch is taken out of the
+// dispatch's count.
+class stage_probe {
+ private:
+  stage stage_;
+  stage_probe* parent_;
+  unsigned long long children_ = 0;
+  unsigned long long start_;
+
+  static auto current() -> stage_probe*& {
+    static thread_local stage_probe* probe = nullptr;
+    return probe;
+  }
+
+ public:
+  explicit stage_probe(stage s) : stage_(s), parent_(current()) {
+    current() = this;
+    start_ = read_cycle_counter();
+  }
+  ~stage_probe() {
+    auto elapsed = read_cycle_counter() - start_;
+    auto& counters = thread_stage_counters();
+    counters.cycles[static_cast<int>(stage_)] += elapsed - children_;
+    ++counters.calls[static_cast<int>(stage_)];
+    if (parent_) parent_->children_ += elapsed;
+    current() = parent_;
+  }
+  stage_probe(const stage_probe&) = delete;
+  void operator=(const stage_probe&) = delete;
+};
+
+#  define FMT_STAGE_PROBE(s) \
+    ::fmt::detail::stage_probe fmt_stage_probe_(::fmt::detail::stage::s)
+// Instrumented visitors cannot be constexpr.
+#  define FMT_CONSTEXPR_UNLESS_INSTRUMENTED
+#else
+#  define FMT_STAGE_PROBE(s) (void)0
+#  define FMT_CONSTEXPR_UNLESS_INSTRUMENTED FMT_CONSTEXPR
+#endif
+
 }  // namespace detail
 
 FMT_BEGIN_EXPORT
@@ -801,7 +995,8 @@ class basic_memory_buffer : public detail::buffer<T> {
     const size_t max_size =
         std::allocator_traits<Allocator>::max_size(self.alloc_);
     size_t old_capacity = buf.capacity();
-    size_t new_capacity = old_capacity + old_capacity / 2;
+    size_t new_capacity =
+        detail::grown_capacity(self.alloc_, old_capacity, size);
     if (size > new_capacity)
       new_capacity = size;
     else if (new_capacity > max_size)
@@ -2169,45 +2364,75 @@ FMT_CONSTEXPR auto write(OutputIt out, basic_string_view<Char> s,
   size_t display_width =
       !is_debug || specs.precision == 0 ? 0 : 1;  // Account for opening '"'.
   size_t size = !is_debug || specs.precision == 0 ? 0 : 1;
-  for_each_codepoint(s, [&](uint32_t cp, string_view sv) {
-    if (is_debug && needs_escape(cp)) {
-      counting_buffer<char> buf;
-      write_escaped_cp(basic_appender<char>(buf),
-                       find_escape_result<char>{sv.begin(), sv.end(), cp});
-      // We're reinterpreting bytes as display width. That's okay
-      // because write_escaped_cp() only writes ASCII characters.
-      size_t cp_width = buf.count();
-      if (display_width + cp_width <= display_width_limit) {
+  if (!is_debug && !is_constant_evaluated()) {
+    // ASCII runs are measured by their size; only the non-ASCII spans in
+    // between are decoded. A valid multibyte sequence has no ASCII bytes, so
+    // splitting at them decodes the same code points.
+    const char* p = s.data();
+    const char* end = p + s.size();
+    bool done = false;
+    while (!done && p != end && display_width < display_width_limit) {
+      size_t ascii = ascii_prefix_size(
+          p, min_of(to_unsigned(end - p), display_width_limit - display_width));
+      p += ascii;
+      display_width += ascii;
+      size += ascii;
+      if (p == end || display_width == display_width_limit) break;
+      const char* span_end = p;
+      while (span_end != end && static_cast<unsigned char>(*span_end) >= 0x80)
+        ++span_end;
+      for_each_codepoint(string_view(p, to_unsigned(span_end - p)),
+                         [&](uint32_t cp, string_view sv) {
+                           size_t cp_width = display_width_of(cp);
+                           if (cp_width + display_width > display_width_limit)
+                             return !(done = true);
+                           display_width += cp_width;
+                           size += sv.size();
+                           return true;
+                         });
+      p = span_end;
+    }
+  } else {
+    for_each_codepoint(s, [&](uint32_t cp, string_view sv) {
+      if (is_debug && needs_escape(cp)) {
+        counting_buffer<char> buf;
+        write_escaped_cp(basic_appender<char>(buf),
+                         find_escape_result<char>{sv.begin(), sv.end(), cp});
+        // We're reinterpreting bytes as display width. That's okay
+        // because write_escaped_cp() only writes ASCII characters.
+        size_t cp_width = buf.count();
+        if (display_width + cp_width <= display_width_limit) {
+          display_width += cp_width;
+          size += cp_width;
+          // If this is the end of the string, account for closing '"'.
+          if (display_width < display_width_limit && sv.end() == s.end()) {
+            ++display_width;
+            ++size;
+          }
+          return true;
+        }
+
+        size += display_width_limit - display_width;
+        display_width = display_width_limit;
+        return false;
+      }
+
+      size_t cp_width = display_width_of(cp);
+      if (cp_width + display_width <= display_width_limit) {
         display_width += cp_width;
-        size += cp_width;
+        size += sv.size();
         // If this is the end of the string, account for closing '"'.
-        if (display_width < display_width_limit && sv.end() == s.end()) {
+        if (is_debug && display_width < display_width_limit &&
+            sv.end() == s.end()) {
           ++display_width;
           ++size;
         }
         return true;
       }
 
-      size += display_width_limit - display_width;
-      display_width = display_width_limit;
       return false;
-    }
-
-    size_t cp_width = display_width_of(cp);
-    if (cp_width + display_width <= display_width_limit) {
-      display_width += cp_width;
-      size += sv.size();
-      // If this is the end of the string, account for closing '"'.
-      if (is_debug && display_width < display_width_limit &&
-          sv.end() == s.end()) {
-        ++display_width;
-        ++size;
-      }
-      return true;
-    }
-
-    return false;
-  });
+    });
+  }
 
   struct bounded_output_iterator {
     reserve_iterator<OutputIt> underlying_iterator;
@@ -3646,6 +3871,7 @@ template <typename Char> struct default_arg_formatter {
 
   template <typename T, FMT_ENABLE_IF(is_builtin<T>::value)>
   void operator()(T value) {
+    FMT_STAGE_PROBE(write);
     write<Char>(out, value);
   }
 
@@ -3655,6 +3881,7 @@ template <typename Char> struct default_arg_formatter {
   }
 
   void operator()(typename basic_format_arg<context>::handle h) {
+    FMT_STAGE_PROBE(dispatch);  // "{}" reaches custom types without a handler
     // Use a null locale since the default format must be unlocalized.
     auto parse_ctx = parse_context<Char>({});
     auto format_ctx = context(out, {}, {});
@@ -3668,7 +3895,8 @@ template <typename Char> struct arg_formatter {
   FMT_NO_UNIQUE_ADDRESS locale_ref locale;
 
   template <typename T, FMT_ENABLE_IF(is_builtin<T>::value)>
-  FMT_CONSTEXPR FMT_INLINE void operator()(T value) {
+  FMT_CONSTEXPR_UNLESS_INSTRUMENTED FMT_INLINE void operator()(T value) {
+    FMT_STAGE_PROBE(write);
     detail::write<Char>(out, value, specs, locale);
   }
 
@@ -3750,6 +3978,7 @@ template <typename Char = char> struct format_handler {
   buffered_context<Char> ctx;
 
   void on_text(const Char* begin, const Char* end) {
+    FMT_STAGE_PROBE(write);
     copy_noinline<Char>(begin, end, ctx.out());
   }
 
@@ -3766,18 +3995,23 @@ template <typename Char = char> struct format_handler {
   }
 
   FMT_INLINE void on_replacement_field(int id, const Char*) {
+    FMT_STAGE_PROBE(dispatch);
     ctx.arg(id).visit(default_arg_formatter<Char>{ctx.out()});
   }
 
   auto on_format_specs(int id, const Char* begin, const Char* end)
       -> const Char* {
+    FMT_STAGE_PROBE(dispatch);
     auto arg = ctx.arg(id);
     if (!arg) report_error("argument not found");
     // Not using a visitor for custom types gives better codegen.
     if (arg.format_custom(begin, parse_ctx, ctx)) return parse_ctx.begin();
 
     auto specs = dynamic_format_specs<Char>();
-    begin = parse_format_specs(begin, end, specs, parse_ctx, arg.type());
+    {
+      FMT_STAGE_PROBE(parse);
+      begin = parse_format_specs(begin, end, specs, parse_ctx, arg.type());
+    }
     if (specs.dynamic()) {
       handle_dynamic_spec(specs.dynamic_width(), specs.width, specs.width_ref,
                           ctx);
@@ -4322,6 +4556,34 @@ FMT_NODISCARD FMT_INLINE auto formatted_size(locale_ref loc,
 
 FMT_API auto vformat(string_view fmt, format_args args) -> std::string;
 
+/**
+ * Formats `args` according to specifications in `fmt` and appends the result
+ * to `out`, writing directly into the string's storage rather than through a
+ * temporary `memory_buffer`. If formatting throws, `out` keeps whatever was
+ * appended before the exception.
+ */
+inline void vformat_append(std::string& out, string_view fmt,
+                           format_args args) {
+  detail::string_buffer buf(out);
+  detail::vformat_to(buf, fmt, args, {});
+}
+
+/**
+ * Formats `args` according to specifications in `fmt` and appends the result
+ * to `out`.
+ *
+ * **Example**:
+ *
+ *     std::string message = "The answer is ";
+ *     fmt::format_append(message, "{}.", 42);
+ */
+template <typename... T>
+FMT_INLINE auto format_append(std::string& out, format_string<T...> fmt,
+                              T&&... args) -> std::string& {
+  vformat_append(out, fmt.str, vargs<T...>{{args...}});
+  return out;
+}
+
 /**
  * Formats `args` according to specifications in `fmt` and returns the result
  * as a string.
@@ -4334,7 +4596,9 @@ FMT_API auto vformat(string_view fmt, format_args args) -> std::string;
 template <typename... T>
 FMT_NODISCARD FMT_INLINE auto format(format_string<T...> fmt, T&&... args)
     -> std::string {
-  return vformat(fmt.str, vargs<T...>{{args...}});
+  auto result = std::string();
+  vformat_append(result, fmt.str, vargs<T...>{{args...}});
+  return result;
 }
 
 /**
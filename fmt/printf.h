@@ -237,12 +237,14 @@ class printf_arg_formatter : public arg_formatter<Char> {
   context_type& context_;
 
   void write_null_pointer(bool is_string = false) {
+    FMT_STAGE_PROBE(write);
     auto s = this->specs;
     s.set_type(presentation_type::none);
     write_bytes<Char>(this->out, is_string ? "(null)" : "(nil)", s);
   }
 
   template <typename T> void write(T value) {
+    FMT_STAGE_PROBE(write);
     detail::write<Char>(this->out, value, this->specs, this->locale);
   }
 
@@ -273,6 +275,7 @@ class printf_arg_formatter : public arg_formatter<Char> {
     // ignored for non-numeric types
     if (s.align() == align::none || s.align() == align::numeric)
       s.set_align(align::right);
+    FMT_STAGE_PROBE(write);
     detail::write<Char>(this->out, static_cast<Char>(value), s);
   }
 
@@ -388,9 +391,43 @@ inline auto parse_printf_presentation_type(char c, type t, bool& upper)
   }
 }
 
+// Returns the presentation type of a conversion whose argument already has
+// the type the conversion expects, so that it needs no conversion: d and i
+// of int or long long, u of their unsigned counterparts, s of a string and
+// e, f and g of a floating-point value. Returns none for everything else,
+// including conversions with a length modifier.
+template <typename Char>
+inline auto printf_fast_type(Char c, type t, bool& upper)
+    -> presentation_type {
+  using pt = presentation_type;
+  switch (c) {
+  case 'd':
+  case 'i':
+    return t == type::int_type || t == type::long_long_type ? pt::dec
+                                                            : pt::none;
+  case 'u':
+    return t == type::uint_type || t == type::ulong_long_type ? pt::dec
+                                                              : pt::none;
+  case 's':
+    return t == type::cstring_type || t == type::string_type ? pt::string
+                                                             : pt::none;
+  case 'e':
+  case 'E':
+  case 'f':
+  case 'F':
+  case 'g':
+  case 'G':
+    return in(t, float_set)
+               ? parse_printf_presentation_type(static_cast<char>(c), t, upper)
+               : pt::none;
+  default: return pt::none;
+  }
+}
+
 template <typename Char, typename Context>
 void vprintf(buffer<Char>& buf, basic_string_view<Char> format,
              basic_format_args<Context> args) {
+  FMT_STAGE_PROBE(parse);
   using iterator = basic_appender<Char>;
   auto out = iterator(buf);
   auto context = basic_printf_context<Char>(out, args);
@@ -418,11 +455,15 @@ void vprintf(buffer<Char>& buf, basic_string_view<Char> format,
     }
     Char c = *it++;
     if (it != end && *it == c) {
+      FMT_STAGE_PROBE(write);
       write(out, basic_string_view<Char>(start, to_unsigned(it - start)));
       start = ++it;
       continue;
     }
-    write(out, basic_string_view<Char>(start, to_unsigned(it - 1 - start)));
+    {
+      FMT_STAGE_PROBE(write);
+      write(out, basic_string_view<Char>(start, to_unsigned(it - 1 - start)));
+    }
 
     auto specs = format_specs();
     specs.set_align(align::right);
@@ -471,6 +512,20 @@ void vprintf(buffer<Char>& buf, basic_string_view<Char> format,
       }
     }
 
+    // The common %d, %s and %.3f: no length modifier and an argument of the
+    // conversion's own type, so there is nothing to convert.
+    bool upper = false;
+    auto fast_type = it != end ? printf_fast_type(*it, arg.type(), upper)
+                               : presentation_type::none;
+    if (fast_type != presentation_type::none) {
+      specs.set_type(fast_type);
+      if (upper) specs.set_upper();
+      start = ++it;
+      FMT_STAGE_PROBE(dispatch);
+      arg.visit(printf_arg_formatter<Char>(out, specs, context));
+      continue;
+    }
+
     // Parse length and convert the argument to the required type.
     c = it != end ? *it++ : 0;
     Char t = it != end ? *it : 0;
@@ -516,7 +571,6 @@ void vprintf(buffer<Char>& buf, basic_string_view<Char> format,
         break;
       }
     }
-    bool upper = false;
     specs.set_type(parse_printf_presentation_type(type, arg.type(), upper));
     if (specs.type() == presentation_type::none)
       report_error("invalid format specifier");
@@ -525,9 +579,13 @@ void vprintf(buffer<Char>& buf, basic_string_view<Char> format,
     start = it;
 
     // Format argument.
+    FMT_STAGE_PROBE(dispatch);
     arg.visit(printf_arg_formatter<Char>(out, specs, context));
   }
-  write(out, basic_string_view<Char>(start, to_unsigned(it - start)));
+  {
+    FMT_STAGE_PROBE(write);
+    write(out, basic_string_view<Char>(start, to_unsigned(it - start)));
+  }
 }
 }  // namespace detail
 